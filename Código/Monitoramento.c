@@ -10,6 +10,12 @@
 #include <WiFiUdp.h>            // Biblioteca para comunicação UDP, usada pelo NTP
 #include <UniversalTelegramBot.h> // Biblioteca para integração com bots do Telegram
 #include <WiFiClientSecure.h>    // Biblioteca para conexões seguras HTTPS com o Telegram
+#include <LittleFS.h>              // Sistema de arquivos na flash, usado para persistir o histórico
+#include <rom/crc.h>               // CRC32 da ROM do ESP32, usado para validar registros gravados
+#include <lwip/sockets.h>          // send() não bloqueante para o canal de eventos (/stream)
+#include <esp_pm.h>                // Gerenciamento de energia: frequência dinâmica e sono leve automático
+#include <esp_heap_caps.h>         // Maior bloco livre do heap, exposto em /metrics (fragmentação)
+#include "pagina_html_gz.h"         // Página web comprimida (gerada por gerar_pagina.py)
 
 /*
  * SEÇÃO 2: CONFIGURAÇÕES DE REDE E TELEGRAM
@@ -24,42 +30,555 @@ WiFiClientSecure client;                      // Cliente seguro para comunicaç
 UniversalTelegramBot bot(BOT_TOKEN, client);   // Instância do bot do Telegram
 
 /*
- * SEÇÃO 3: CONFIGURAÇÃO DO SENSOR DHT22
- * Define o pino e tipo do sensor DHT22, além dos parâmetros para alertas de temperatura.
+ * SEÇÃO 3: CONFIGURAÇÃO DOS SENSORES
+ * Define a interface comum dos sensores, a implementação para o DHT22 e os sensores instalados.
+ * Outros tipos de sensor só precisam implementar iniciar() e ler(); os canais que os usam são
+ * registrados na seção 4, e as regras de alerta sobre eles, na seção 7.
  */
+class Sensor {
+ public:
+  virtual ~Sensor() {}
+  virtual void iniciar() = 0;                               // Prepara o pino ou barramento do sensor
+  virtual bool ler(float& temperatura, float& umidade) = 0; // Retorna false se a leitura for inválida
+};
+
+class SensorDHT : public Sensor {
+ public:
+  SensorDHT(uint8_t pino, uint8_t tipo) : dht(pino, tipo) {}
+
+  void iniciar() override { dht.begin(); }
+
+  // Uma transação no barramento (alguns ms, com interrupções desligadas); a temperatura reaproveita
+  // os bytes lidos junto com a umidade, pois a biblioteca guarda a última leitura por 2 s
+  bool ler(float& temperatura, float& umidade) override {
+    umidade = dht.readHumidity();
+    temperatura = dht.readTemperature();
+    return !isnan(umidade) && !isnan(temperatura);
+  }
+
+ private:
+  DHT dht;
+};
+
 #define DHTPIN 4                  // Pino GPIO conectado ao sensor DHT22
 #define DHTTYPE DHT22             // Tipo de sensor (DHT22 para maior precisão)
-DHT dht(DHTPIN, DHTTYPE);         // Instância do sensor DHT22
-const float TEMP_THRESHOLD = 24.5; // Limite de temperatura para envio de alertas (°C)
-unsigned long lastAlertTime = 0;  // Timestamp do último alerta enviado (ms)
-const unsigned long ALERT_INTERVAL = 60000; // Intervalo mínimo entre alertas (1 minuto, em ms)
+SensorDHT sensorPrincipal(DHTPIN, DHTTYPE); // Sensor DHT22 original (canal 0)
+// SensorDHT sensorRack2(16, DHTTYPE);      // Exemplo: segunda sonda no GPIO 16 (registrar em "canais")
 
 /*
  * SEÇÃO 4: ESTRUTURAS DE DADOS
- * Define arrays para armazenar o histórico de leituras, médias horárias e logs de eventos.
- * Usa buffers circulares para gerenciar espaço de forma eficiente.
+ * Define o buffer circular genérico, o registro compacto de amostra, a série comprimida que guarda
+ * o histórico de leituras e a cascata de níveis de agregação (1 min, 1 h, 1 dia) com contagem, mínimo, máximo, média e
+ * variância. As entradas de log são geradas a partir das próprias leituras.
  */
-const int maxLeituras = 10;            // Máximo de leituras armazenadas (10 leituras)
-float historicoTemperatura[maxLeituras]; // Array para temperaturas
-float historicoUmidade[maxLeituras];    // Array para umidades
-String timestamps[maxLeituras];         // Array para timestamps das leituras
-int indiceLeitura = 0;                 // Índice atual do buffer de leituras
-int totalLeituras = 0;                 // Total de leituras armazenadas
-
-const int maxHoras = 10;               // Máximo de médias horárias armazenadas
-float mediasTemperatura[maxHoras];     // Array para médias horárias de temperatura
-float mediasUmidade[maxHoras];         // Array para médias horárias de umidade
-String horas[maxHoras];                // Array para timestamps das médias horárias
-int indiceHora = 0;                    // Índice atual do buffer de médias
-int totalHoras = 0;                    // Total de médias horárias armazenadas
-float somaTemperatura = 0;             // Soma das temperaturas para cálculo da média
-float somaUmidade = 0;                 // Soma das umidades para cálculo da média
-int leiturasPorHora = 0;               // Contador de leituras em uma hora
-
-const int maxLog = 10;                 // Máximo de entradas de log
-String logEntradas[maxLog];            // Array para armazenar logs
-int indiceLog = 0;                     // Índice atual do buffer de logs
-int totalLog = 0;                      // Total de entradas de log
+// Buffer circular de capacidade fixa N (potência de 2, para que o índice seja uma máscara de bits).
+// O índice 0 é o elemento mais antigo; push() sobrescreve o mais antigo quando o buffer está cheio.
+template <typename T, size_t N>
+class RingBuffer {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "A capacidade do RingBuffer deve ser potência de 2");
+
+ public:
+  typedef T Item;
+
+  class const_iterator {
+   public:
+    const_iterator(const RingBuffer* buffer, uint32_t posicao) : buffer(buffer), posicao(posicao) {}
+    const T& operator*() const { return buffer->itens[posicao & (N - 1)]; }
+    const T* operator->() const { return &**this; }
+    const_iterator& operator++() { posicao++; return *this; }
+    const_iterator operator+(size_t n) const { return const_iterator(buffer, posicao + n); }
+    bool operator==(const const_iterator& outro) const { return posicao == outro.posicao; }
+    bool operator!=(const const_iterator& outro) const { return posicao != outro.posicao; }
+
+   private:
+    const RingBuffer* buffer;
+    uint32_t posicao;                  // Posição absoluta (contagem de push), reduzida pela máscara
+  };
+
+  void push(const T& item) {
+    itens[escritos & (N - 1)] = item;
+    escritos++;
+  }
+
+  size_t size() const { return escritos < N ? escritos : N; }
+  bool empty() const { return escritos == 0; }
+  static constexpr size_t capacity() { return N; }
+  uint32_t total() const { return escritos; } // Quantos push() já ocorreram (sequência do mais recente)
+  const T& operator[](size_t i) const { return itens[(escritos - size() + i) & (N - 1)]; }
+  const T& back() const { return itens[(escritos - 1) & (N - 1)]; }
+
+  const_iterator begin() const { return const_iterator(this, escritos - size()); }
+  const_iterator end() const { return const_iterator(this, escritos); }
+  // Iterador para os "n" elementos mais recentes (ou todos, se houver menos)
+  const_iterator ultimos(size_t n) const { return const_iterator(this, escritos - (uint32_t)(n < size() ? n : size())); }
+
+ private:
+  T itens[N];
+  uint32_t escritos = 0;
+};
+
+// Amostra compacta (8 bytes): instante e valores em centésimos, sem floats nem Strings
+struct Amostra {
+  uint32_t epoch;                      // Instante da leitura (segundos, fuso local)
+  int16_t temperatura;                 // Temperatura em centésimos de °C (ex.: 2450 = 24,50 °C)
+  uint16_t umidade;                    // Umidade em centésimos de % (ex.: 5010 = 50,10 %)
+};
+static_assert(sizeof(Amostra) == 8, "Amostra deve ocupar 8 bytes");
+
+int32_t paraCentesimos(float valor) {
+  return (int32_t)lroundf(valor * 100.0f); // Arredonda para o centésimo mais próximo
+}
+
+
+/*
+ * Série de amostras comprimida em memória (no estilo do Gorilla, do Facebook). As leituras entram
+ * num bloco aberto de AMOSTRAS_BLOCO amostras sem compressão; quando ele enche, é selado: codificado
+ * bit a bit numa arena circular de BYTES bytes. Cada bloco selado guarda a primeira amostra inteira
+ * e, para as demais, o delta-do-delta do instante (1 bit com leitura periódica) e o delta de cada
+ * valor com prefixo de tamanho variável, divididos por 10 quando o bloco inteiro está em décimos
+ * (resolução do DHT22). Os blocos mais antigos são descartados quando a arena enche. Como no
+ * RingBuffer, o índice 0 é a amostra mais antiga e total() conta todos os push().
+ */
+const uint8_t LARGURAS_INSTANTE[4] = {7, 9, 12, 32}; // Bits do delta-do-delta do instante, por classe
+const uint8_t LARGURAS_VALOR[4] = {3, 7, 11, 17};     // Bits do delta de temperatura/umidade, por classe
+
+template <size_t BYTES, size_t BLOCOS>
+class SerieComprimida {
+  static_assert(BYTES > 0 && (BYTES & (BYTES - 1)) == 0, "A arena deve ter tamanho potência de 2");
+  static_assert(BLOCOS > 0 && (BLOCOS & (BLOCOS - 1)) == 0, "O número de blocos deve ser potência de 2");
+
+ public:
+  typedef Amostra Item;
+  static const uint32_t AMOSTRAS_BLOCO = 128; // Amostras por bloco selado
+  static const uint32_t MAXIMO_BITS_BLOCO = 1 + 64 + (AMOSTRAS_BLOCO - 1) * (36 + 21 + 21); // Pior caso
+  static_assert(MAXIMO_BITS_BLOCO / 8 + 1 < BYTES, "A arena deve comportar ao menos um bloco");
+
+  // Percorre a série decodificando um bloco por vez; avançar é O(1) amortizado
+  class const_iterator {
+   public:
+    const_iterator() : serie(NULL), posicao(0) {}
+    const_iterator(const SerieComprimida* serie, uint32_t posicao) : serie(serie), posicao(posicao) {}
+    const Amostra& operator*() const { sincronizar(); return atual; }
+    const Amostra* operator->() const { return &**this; }
+    const_iterator& operator++() { posicao++; return *this; }
+    bool operator==(const const_iterator& outro) const { return posicao == outro.posicao; }
+    bool operator!=(const const_iterator& outro) const { return posicao != outro.posicao; }
+    uint32_t sequencia() const { return posicao; } // Posição absoluta (contagem de push)
+
+   private:
+    // Decodifica até "posicao", continuando de onde parou se ela estiver adiante no mesmo bloco
+    void sincronizar() const {
+      if (decodificada == posicao && bloco != NENHUM_BLOCO) return;
+      uint32_t indice = posicao / AMOSTRAS_BLOCO;
+      if (indice >= serie->blocosSelados) { // Bloco aberto: leitura direta
+        bloco = NENHUM_BLOCO;
+        atual = serie->aberto[posicao % AMOSTRAS_BLOCO];
+        return;
+      }
+      if (bloco != indice || decodificada > posicao) {
+        bloco = indice;
+        decodificada = indice * AMOSTRAS_BLOCO;
+        bit = serie->inicioBloco[indice & (BLOCOS - 1)];
+        escala = serie->lerBits(bit, 1) ? 10 : 1;
+        atual.epoch = serie->lerBits(bit, 32);
+        atual.temperatura = (int16_t)serie->lerBits(bit, 16);
+        atual.umidade = (uint16_t)serie->lerBits(bit, 16);
+        intervalo = INTERVALO_NOMINAL;
+      }
+      while (decodificada < posicao) {
+        intervalo += serie->decodificar(bit, LARGURAS_INSTANTE);
+        atual.epoch += intervalo;
+        atual.temperatura += serie->decodificar(bit, LARGURAS_VALOR) * escala;
+        atual.umidade += serie->decodificar(bit, LARGURAS_VALOR) * escala;
+        decodificada++;
+      }
+    }
+
+    static const uint32_t NENHUM_BLOCO = 0xFFFFFFFF;
+    const SerieComprimida* serie;
+    uint32_t posicao;
+    mutable uint32_t bloco = NENHUM_BLOCO; // Bloco selado em decodificação
+    mutable uint32_t decodificada = 0;     // Posição da amostra em "atual"
+    mutable uint32_t bit = 0;              // Próximo bit do bloco na arena (posição absoluta)
+    mutable int32_t intervalo = 0;         // Último intervalo entre instantes (s)
+    mutable int32_t escala = 1;            // 10 se o bloco foi gravado em décimos
+    mutable Amostra atual = {};
+  };
+
+  void push(const Amostra& amostra) {
+    aberto[escritos % AMOSTRAS_BLOCO] = amostra;
+    escritos++;
+    if (escritos % AMOSTRAS_BLOCO == 0) selar();
+  }
+
+  size_t size() const { return escritos - primeiroBloco * AMOSTRAS_BLOCO; }
+  bool empty() const { return escritos == 0; }
+  uint32_t total() const { return escritos; } // Quantos push() já ocorreram (sequência do mais recente)
+  const Amostra& back() const { return aberto[(escritos - 1) % AMOSTRAS_BLOCO]; } // Ainda no bloco recém-selado
+  // Bits ocupados na arena pelos blocos selados guardados
+  uint32_t bitsSelados() const {
+    return blocosSelados > primeiroBloco ? fimArena - inicioBloco[primeiroBloco & (BLOCOS - 1)] : 0;
+  }
+  // Tamanho médio de uma amostra selada, em centésimos de bit (0 se nenhum bloco foi selado)
+  uint32_t centesimosDeBitPorAmostra() const {
+    uint32_t seladas = (blocosSelados - primeiroBloco) * AMOSTRAS_BLOCO;
+    return seladas ? (uint32_t)((uint64_t)bitsSelados() * 100 / seladas) : 0;
+  }
+
+  // Bits que a arena comporta em regime (um bloco no pior caso fica sempre livre para a selagem)
+  static constexpr uint32_t bitsUteis() { return BYTES * 8 - MAXIMO_BITS_BLOCO; }
+
+  // Estimativa dos bits que "n" leituras consecutivas ocupariam seladas, com a parte proporcional
+  // do cabeçalho de bloco; usada para recuperar da flash apenas o que cabe na arena
+  static uint32_t bitsEstimados(const Amostra* amostras, size_t n) {
+    int32_t escala = 10;
+    for (size_t i = 0; i < n; i++) {
+      if (amostras[i].temperatura % 10 != 0 || amostras[i].umidade % 10 != 0) escala = 1;
+    }
+    uint32_t diferencas = 0;
+    int32_t intervalo = INTERVALO_NOMINAL;
+    for (size_t i = 1; i < n; i++) {
+      int32_t novoIntervalo = (int32_t)(amostras[i].epoch - amostras[i - 1].epoch);
+      diferencas += bitsCodificados(novoIntervalo - intervalo, LARGURAS_INSTANTE);
+      intervalo = novoIntervalo;
+      diferencas += bitsCodificados((amostras[i].temperatura - amostras[i - 1].temperatura) / escala, LARGURAS_VALOR);
+      diferencas += bitsCodificados(((int32_t)amostras[i].umidade - amostras[i - 1].umidade) / escala, LARGURAS_VALOR);
+    }
+    if (n > 1) diferencas += diferencas / (n - 1); // A diferença para a leitura anterior a este trecho
+    return diferencas + (uint32_t)((1 + 64 + 7) * n / AMOSTRAS_BLOCO);
+  }
+
+  const_iterator iterador(uint32_t sequencia) const { return const_iterator(this, sequencia); }
+  const_iterator begin() const { return const_iterator(this, escritos - size()); }
+  const_iterator end() const { return const_iterator(this, escritos); }
+  // Iterador para os "n" elementos mais recentes (ou todos, se houver menos)
+  const_iterator ultimos(size_t n) const { return const_iterator(this, escritos - (uint32_t)(n < size() ? n : size())); }
+
+  // Sequência da primeira amostra com epoch >= "epoch" (total() se nenhuma): busca binária pelo
+  // instante inicial dos blocos selados e varredura dentro de um único bloco
+  uint32_t primeiraComEpoch(uint32_t epoch) const {
+    uint32_t inicio = primeiroBloco, fim = blocosSelados;
+    while (inicio < fim) {
+      uint32_t meio = inicio + (fim - inicio) / 2;
+      uint32_t bit = inicioBloco[meio & (BLOCOS - 1)] + 1; // Pula a indicação de escala
+      if (lerBits(bit, 32) < epoch) inicio = meio + 1;
+      else fim = meio;
+    }
+    uint32_t sequencia = (inicio > primeiroBloco ? inicio - 1 : primeiroBloco) * AMOSTRAS_BLOCO;
+    for (const_iterator it = iterador(sequencia); it != end(); ++it) {
+      if (it->epoch >= epoch) return it.sequencia();
+    }
+    return escritos;
+  }
+
+ private:
+  static const int32_t INTERVALO_NOMINAL = 10;           // Intervalo esperado entre leituras (s)
+
+  // Codifica o bloco aberto (completo) no fim da arena, liberando antes o espaço necessário
+  void selar() {
+    while (blocosSelados - primeiroBloco == BLOCOS ||
+           (blocosSelados > primeiroBloco && fimArena - inicioBloco[primeiroBloco & (BLOCOS - 1)] + MAXIMO_BITS_BLOCO > BYTES * 8)) {
+      primeiroBloco++; // Descarta o bloco mais antigo
+    }
+
+    int32_t escala = 10;
+    for (const Amostra& amostra : aberto) {
+      if (amostra.temperatura % 10 != 0 || amostra.umidade % 10 != 0) escala = 1;
+    }
+    uint32_t bit = fimArena;
+    inicioBloco[blocosSelados & (BLOCOS - 1)] = bit;
+    escreverBits(bit, escala == 10, 1);
+    escreverBits(bit, aberto[0].epoch, 32);
+    escreverBits(bit, (uint16_t)aberto[0].temperatura, 16);
+    escreverBits(bit, aberto[0].umidade, 16);
+    int32_t intervalo = INTERVALO_NOMINAL;
+    for (uint32_t i = 1; i < AMOSTRAS_BLOCO; i++) {
+      int32_t novoIntervalo = (int32_t)(aberto[i].epoch - aberto[i - 1].epoch);
+      codificar(bit, novoIntervalo - intervalo, LARGURAS_INSTANTE);
+      intervalo = novoIntervalo;
+      codificar(bit, (aberto[i].temperatura - aberto[i - 1].temperatura) / escala, LARGURAS_VALOR);
+      codificar(bit, ((int32_t)aberto[i].umidade - aberto[i - 1].umidade) / escala, LARGURAS_VALOR);
+    }
+    fimArena = (bit + 7) & ~7u; // Blocos começam em byte inteiro
+    blocosSelados++;
+  }
+
+  // Grava os "n" bits menos significativos de "valor", do mais significativo ao menos. As posições
+  // são absolutas e crescem sempre; a máscara as reduz à arena (também ao dar a volta em 2^32)
+  void escreverBits(uint32_t& bit, uint32_t valor, int n) {
+    for (int i = n - 1; i >= 0; i--, bit++) {
+      uint8_t& byte = arena[(bit >> 3) & (BYTES - 1)];
+      uint8_t mascara = 0x80 >> (bit & 7);
+      if ((valor >> i) & 1) byte |= mascara;
+      else byte &= ~mascara;
+    }
+  }
+
+  uint32_t lerBits(uint32_t& bit, int n) const {
+    uint32_t valor = 0;
+    for (int i = 0; i < n; i++, bit++) {
+      valor = (valor << 1) | ((arena[(bit >> 3) & (BYTES - 1)] >> (7 - (bit & 7))) & 1);
+    }
+    return valor;
+  }
+
+  // Menor classe (0 a 3) cuja largura comporta o valor diferente de zero
+  static int classeDe(int32_t valor, const uint8_t larguras[4]) {
+    int classe = 0;
+    while (classe < 3 && (valor < -(1 << (larguras[classe] - 1)) || valor >= (1 << (larguras[classe] - 1)))) classe++;
+    return classe;
+  }
+
+  static uint32_t bitsCodificados(int32_t valor, const uint8_t larguras[4]) {
+    if (valor == 0) return 1;
+    int classe = classeDe(valor, larguras);
+    return (classe < 3 ? classe + 2 : 4) + larguras[classe];
+  }
+
+  // Prefixo '0' para zero; '10', '110', '1110' e '1111' seguidos de larguras[0..3] bits em
+  // complemento de 2 para valores que cabem nessa largura
+  void codificar(uint32_t& bit, int32_t valor, const uint8_t larguras[4]) {
+    if (valor == 0) {
+      escreverBits(bit, 0, 1);
+      return;
+    }
+    int classe = classeDe(valor, larguras);
+    if (classe < 3) escreverBits(bit, ((1u << (classe + 1)) - 1) << 1, classe + 2); // '10', '110' ou '1110'
+    else escreverBits(bit, 0xF, 4);
+    escreverBits(bit, (uint32_t)valor, larguras[classe]);
+  }
+
+  int32_t decodificar(uint32_t& bit, const uint8_t larguras[4]) const {
+    int classe = 0;
+    while (classe < 4 && lerBits(bit, 1)) classe++;
+    if (classe == 0) return 0;
+    int n = larguras[classe - 1];
+    uint32_t valor = lerBits(bit, n);
+    if (n < 32 && (valor & (1u << (n - 1)))) valor |= ~0u << n; // Estende o sinal
+    return (int32_t)valor;
+  }
+
+  Amostra aberto[AMOSTRAS_BLOCO];     // Bloco em preenchimento, sem compressão
+  uint32_t inicioBloco[BLOCOS];       // Primeiro bit de cada bloco selado na arena (índice & máscara)
+  uint8_t arena[BYTES];               // Blocos selados, em sequência circular
+  uint32_t escritos = 0;
+  uint32_t blocosSelados = 0;         // Blocos já selados (índice do próximo)
+  uint32_t primeiroBloco = 0;         // Bloco selado mais antigo ainda na arena
+  uint32_t fimArena = 0;              // Próximo bit livre (posição absoluta)
+};
+
+// Histórico de leituras (nível bruto, 10 s). Um DHT22 com ruído ocupa ~10,7 bits por leitura e 32 KB
+// guardam ~2,7 dias, contra ~11 horas com os registros de 8 bytes; com resolução de 0,01, ~20 bits
+// e ~1,5 dia (medido com `benchmark serie`, em Simulação/)
+SerieComprimida<32768, 1024> historico;
+
+// Estatísticas de uma janela em centésimos: contagem, mínimo, máximo, média e soma dos quadrados
+// dos desvios (algoritmo de Welford), atualizadas em O(1) por amostra ou por janela combinada.
+struct Estatistica {
+  uint32_t n;                          // Quantidade de amostras
+  int16_t minimo;                      // Menor valor
+  int16_t maximo;                      // Maior valor
+  float media;                         // Média
+  float m2;                            // Soma dos quadrados dos desvios (variância = m2 / n)
+
+  // Combina outra janela nesta (fórmula de Chan et al.); uma amostra é uma janela com n = 1
+  void combinar(const Estatistica& outra) {
+    if (outra.n == 0) return;
+    if (n == 0) { *this = outra; return; }
+    uint32_t total = n + outra.n;
+    float delta = outra.media - media;
+    media += delta * outra.n / total;
+    m2 += outra.m2 + delta * delta * ((float)n * outra.n / total);
+    if (outra.minimo < minimo) minimo = outra.minimo;
+    if (outra.maximo > maximo) maximo = outra.maximo;
+    n = total;
+  }
+
+  float variancia() const { return n > 0 ? m2 / n : 0; }
+};
+
+// Janela de agregação de um nível: início da janela e estatísticas de temperatura e umidade
+struct Agregado {
+  uint32_t epoch;                      // Início da janela (segundos, fuso local)
+  Estatistica temperatura;             // Estatísticas de temperatura (centésimos de °C)
+  Estatistica umidade;                 // Estatísticas de umidade (centésimos de %)
+
+  static Agregado de(const Amostra& amostra) {
+    return {amostra.epoch,
+            {1, amostra.temperatura, amostra.temperatura, (float)amostra.temperatura, 0},
+            {1, (int16_t)amostra.umidade, (int16_t)amostra.umidade, (float)amostra.umidade, 0}};
+  }
+
+  void combinar(const Agregado& outro) {
+    temperatura.combinar(outro.temperatura);
+    umidade.combinar(outro.umidade);
+  }
+
+  Amostra media() const { // Médias no formato compacto de amostra
+    return {epoch, (int16_t)lroundf(temperatura.media), (uint16_t)lroundf(umidade.media)};
+  }
+};
+
+// Nível de agregação: janelas de "resolucao" segundos alinhadas ao relógio. A janela em andamento
+// acumula o que chega do nível inferior; ao chegar dado de uma janela nova, a anterior é fechada,
+// guardada e repassada ao nível superior.
+template <size_t N>
+struct NivelAgregacao {
+  const char* nome;                    // Nome exibido nas consultas
+  uint32_t resolucao;                  // Duração de cada janela (segundos)
+  RingBuffer<Agregado, N> fechados;    // Janelas concluídas, da mais antiga à mais recente
+  Agregado aberto;                     // Janela em andamento
+  bool temAberto;                      // Se "aberto" já recebeu algum dado
+  uint32_t piso;                       // Dados anteriores a este instante já estão em "fechados" (recuperação)
+
+  NivelAgregacao(const char* nome, uint32_t resolucao) : nome(nome), resolucao(resolucao), temAberto(false), piso(0) {}
+
+  // Acumula "parcial"; retorna true e preenche "fechado" quando isso encerra a janela anterior
+  bool acumular(const Agregado& parcial, Agregado& fechado) {
+    if (parcial.epoch < piso) return false; // Janela já recuperada da flash: não conta de novo
+    uint32_t inicio = parcial.epoch - parcial.epoch % resolucao;
+    bool fechou = temAberto && inicio != aberto.epoch;
+    if (fechou) {
+      fechado = aberto;
+      fechados.push(aberto);
+    }
+    if (!temAberto || fechou) {
+      aberto = parcial;
+      aberto.epoch = inicio;
+      temAberto = true;
+    } else {
+      aberto.combinar(parcial);
+    }
+    return fechou;
+  }
+};
+
+NivelAgregacao<128> nivelMinuto("minuto", 60);   // 1 min, ~2 horas
+NivelAgregacao<256> nivelHora("hora", 3600);     // 1 h, ~10 dias
+NivelAgregacao<64> nivelDia("dia", 86400);       // 1 dia, ~2 meses
+
+const int FECHOU_HORA = 1;              // Retorno de agregarAmostra: uma janela de 1 h foi fechada
+const int FECHOU_DIA = 2;               // Retorno de agregarAmostra: uma janela de 1 dia foi fechada
+
+// Propaga uma leitura pela cascata bruto -> minuto -> hora -> dia (O(1) por leitura); retorna quais
+// janelas de hora/dia foram fechadas, preenchendo "hora" e "dia"
+int agregarAmostra(const Amostra& amostra, Agregado& hora, Agregado& dia) {
+  Agregado minuto;
+  int fechados = 0;
+  if (nivelMinuto.acumular(Agregado::de(amostra), minuto) && nivelHora.acumular(minuto, hora)) {
+    fechados |= FECHOU_HORA;
+    if (nivelDia.acumular(hora, dia)) fechados |= FECHOU_DIA;
+  }
+  return fechados;
+}
+
+// Soma as janelas de um nível que começam a partir de "desde", incluindo a janela em andamento;
+// "total.epoch" passa a ser o início da janela mais antiga somada
+template <size_t N>
+void resumirNivel(const NivelAgregacao<N>& nivel, uint32_t desde, Agregado& total) {
+  for (size_t i = nivel.fechados.size(); i > 0 && nivel.fechados[i - 1].epoch >= desde; i--) {
+    total.combinar(nivel.fechados[i - 1]);
+    total.epoch = nivel.fechados[i - 1].epoch;
+  }
+  if (nivel.temAberto && nivel.aberto.epoch >= desde) {
+    total.combinar(nivel.aberto);
+    if (nivel.aberto.epoch < total.epoch) total.epoch = nivel.aberto.epoch;
+  }
+}
+
+// Início do período guardado por um nível ("agora" se ainda não recebeu dados)
+template <size_t N>
+uint32_t inicioNivel(const NivelAgregacao<N>& nivel, uint32_t agora) {
+  if (nivel.fechados.size() > 0) return nivel.fechados[0].epoch;
+  return nivel.temAberto ? nivel.aberto.epoch : agora;
+}
+
+/*
+ * Resume os últimos "segundos" pelo nível mais fino que ainda guarda o início da janela (o minuto
+ * retém ~2 horas e a hora ~10 dias; após reiniciar, o minuto só tem o período desde a partida). Se
+ * nenhum nível o guarda, fica o mais fino ao qual falta menos de uma janela do mais grosso. As
+ * janelas em andamento dos níveis mais finos completam o período mais recente, ainda não repassado
+ * ao nível escolhido. "total.epoch" é o início efetivo do resumo, que pode ser posterior a
+ * agora - segundos. Retorna o nível usado.
+ */
+const char* resumirJanela(uint32_t agora, uint32_t segundos, Agregado& total, uint32_t& resolucao) {
+  uint32_t desde = agora > segundos ? agora - segundos : 0;
+  uint32_t inicioDia = inicioNivel(nivelDia, agora);
+  uint32_t inicioHora = inicioNivel(nivelHora, agora);
+  uint32_t inicioMinuto = inicioNivel(nivelMinuto, agora);
+  bool usarHora = inicioHora <= desde || (inicioDia > desde && inicioHora < inicioDia + nivelDia.resolucao);
+  bool usarMinuto = usarHora && (inicioMinuto <= desde || (inicioHora > desde && inicioMinuto < inicioHora + nivelHora.resolucao));
+  total = {agora, {}, {}};
+  if (usarMinuto) {
+    resumirNivel(nivelMinuto, desde, total);
+    resolucao = nivelMinuto.resolucao;
+    return nivelMinuto.nome;
+  }
+  if (usarHora) {
+    resumirNivel(nivelHora, desde, total);
+    if (nivelMinuto.temAberto) total.combinar(nivelMinuto.aberto);
+    resolucao = nivelHora.resolucao;
+    return nivelHora.nome;
+  }
+  resumirNivel(nivelDia, desde, total);
+  if (nivelHora.temAberto) total.combinar(nivelHora.aberto);
+  if (nivelMinuto.temAberto) total.combinar(nivelMinuto.aberto);
+  resolucao = nivelDia.resolucao;
+  return nivelDia.nome;
+}
+
+// Canal de medição: um sensor com histórico recente e estatísticas próprias desde a inicialização
+const size_t capacidadeCanal = 256;    // Leituras mantidas por canal (~43 minutos a cada 10 s, 2 KB)
+struct Canal {
+  const char* nome;                    // Nome exibido nas consultas (ex.: "rack1-topo")
+  Sensor* sensor;                      // Sensor que alimenta o canal
+  RingBuffer<Amostra, capacidadeCanal> historico; // Leituras recentes do canal
+  Agregado acumulado;                  // Estatísticas desde a primeira leitura válida
+  uint32_t falhas;                     // Leituras inválidas (sensor ausente, timeout, checksum)
+
+  Canal(const char* nome, Sensor* sensor) : nome(nome), sensor(sensor), acumulado(), falhas(0) {}
+
+  void registrar(const Amostra& amostra) {
+    if (historico.empty()) acumulado.epoch = amostra.epoch; // Início do período acumulado
+    historico.push(amostra);
+    acumulado.combinar(Agregado::de(amostra)); // O(1): Welford/Chan, como nos níveis de agregação
+  }
+};
+
+// Canais instalados. O canal 0 alimenta o histórico principal, a flash, os alertas e o /stream;
+// os demais mantêm apenas histórico e estatísticas próprios (consultados em /canais).
+// CANAIS_ADICIONAIS acrescenta canais sem editar a lista (usado pela simulação no computador).
+#ifndef CANAIS_ADICIONAIS
+#define CANAIS_ADICIONAIS
+#endif
+Canal canais[] = {
+  {"principal", &sensorPrincipal},
+  // {"rack2", &sensorRack2},
+  CANAIS_ADICIONAIS
+};
+const int NUM_CANAIS = sizeof(canais) / sizeof(canais[0]);
+const int CANAL_PRINCIPAL = 0;
+
+// Leitura de um canal, entregue pela tarefa de sensores ao loop (seção 13)
+struct LeituraCanal {
+  uint8_t canal;                      // Índice em "canais"
+  bool valida;                        // false se o sensor não respondeu ou o checksum falhou
+  float temperatura;                  // Temperatura lida (°C)
+  float umidade;                      // Umidade lida (%)
+};
+
+const int TAMANHO_FILA_LEITURAS = 16;           // Leituras pendentes antes de começar a descartar
+QueueHandle_t filaLeituras = NULL;              // Fila entre a tarefa de sensores e o loop
+volatile unsigned long leiturasDescartadas = 0; // Leituras perdidas por fila cheia
+
+const int maxLeituras = 10;            // Leituras exibidas no gráfico (/dados)
+const int maxHoras = 10;               // Médias (nível de 1 minuto) exibidas no gráfico (/dados)
+const int maxLog = 10;                 // Entradas de log exibidas (/dados)
+
+// Números de sequência: crescem a cada registro armazenado e nunca se repetem durante a execução.
+// A sequência de um registro é a sua posição na ordem de chegada (RingBuffer::total() para o mais
+// recente), então não precisa ser guardada. As entradas de log têm a sequência da leitura.
+uint32_t idBoot = 0;                   // Identificador aleatório desta execução (detecta reinicializações)
 
 /*
  * SEÇÃO 5: CONFIGURAÇÃO DO SERVIDOR WEB E NTP
@@ -70,268 +589,1917 @@ WiFiUDP ntpUDP;                        // Instância UDP para comunicação com
 NTPClient timeClient(ntpUDP, "pool.ntp.org", -10800, 60000); // Cliente NTP: servidor pool.ntp.org, fuso horário UTC-3 (-10800s), atualização a cada 60s
 
 /*
- * SEÇÃO 6: CONTROLE DE TEMPORIZAÇÃO
- * Define variáveis para controlar os intervalos de leitura do sensor e cálculo de médias horárias.
+ * SEÇÃO 6: CONTROLE DE TEMPORIZAÇÃO, ENERGIA E INSTRUMENTAÇÃO
+ * Agendador de temporizadores periódicos com prazos absolutos. O loop executa os temporizadores
+ * vencidos e depois dorme até o próximo prazo, a chegada de uma leitura ou a próxima verificação
+ * da rede, em vez de girar comparando millis(). A rede ainda é verificada por sondagem a cada
+ * intervaloRede (10 ms), então o loop acorda ~100 vezes por segundo mesmo sem eventos. O sono leve
+ * automático só é usado se o firmware tiver tickless idle (ver configurarEnergia), o que o núcleo
+ * Arduino-ESP32 padrão não tem; o consumo não foi medido. Cada temporizador mede o atraso de
+ * disparo (jitter) e conta os prazos perdidos. Histogramas de latência medem os trechos críticos
+ * (loop, handlers, sensores, NTP, Telegram) e são expostos em /metrics.
  */
-unsigned long ultimoTempoLeitura = 0; // Timestamp da última leitura do sensor (ms)
-const unsigned long intervaloLeitura = 10000; // Intervalo entre leituras (10 segundos, em ms)
-unsigned long ultimaHora = 0;         // Timestamp da última média horária (ms)
-const unsigned long intervaloHora = 60000; // Intervalo para médias horárias (1 minuto, em ms)
+const unsigned long intervaloLeitura = 10000; // Intervalo entre leituras de cada canal (10 segundos, em ms)
+const unsigned long intervaloSincronizacao = 60000; // Intervalo entre sincronizações NTP (1 minuto, em ms)
+const unsigned long intervaloRede = 10;       // Espera máxima do loop antes de sondar o servidor web (ms)
+
+struct Temporizador {
+  const char* nome;                    // Nome exibido em /agenda
+  void (*funcao)();                    // Executada pelo loop; NULL se outra tarefa FreeRTOS dispara os prazos
+  unsigned long periodo;               // Intervalo entre disparos (ms)
+  unsigned long prazo;                 // millis() do próximo disparo
+  uint32_t execucoes;                  // Disparos realizados
+  uint32_t atrasoTotal;                // Soma dos atrasos em relação ao prazo (ms), para a média
+  uint32_t atrasoMaximo;               // Maior atraso observado (ms)
+  uint32_t perdidos;                   // Prazos pulados porque o disparo atrasou um período inteiro
+};
+
+const int MAX_TEMPORIZADORES = 4;
+Temporizador temporizadores[MAX_TEMPORIZADORES];
+int numTemporizadores = 0;
+unsigned long despertares = 0;        // Passagens pelo loop (~100 por segundo: verificação da rede a cada intervaloRede)
+bool sonoLeveAtivo = false;           // Se o gerenciamento de energia aceitou o sono leve automático
+bool frequenciaDinamicaAtiva = false; // Se o gerenciamento de energia aceitou a frequência dinâmica
+esp_pm_lock_handle_t travaFrequencia = NULL; // Mantém o CPU na frequência máxima durante leituras temporizadas
+
+// Histograma de latência com baldes fixos em potências de 2 (16 µs a ~524 ms, mais +Inf). Cada
+// histograma é atualizado por uma única tarefa: registrar() calcula o balde com um clz e faz três
+// somas, sem alocação nem trava; /metrics apenas lê os contadores.
+const int BALDES_LATENCIA = 16;
+struct Histograma {
+  const char* nome;                    // Rótulo "operacao" em /metrics
+  uint32_t baldes[BALDES_LATENCIA + 1]; // Contagem por balde (não cumulativa); o último é +Inf
+  uint32_t contagem;                   // Eventos registrados
+  uint64_t soma;                       // Soma das durações (µs)
+
+  explicit Histograma(const char* nome) : nome(nome), baldes(), contagem(0), soma(0) {}
+
+  static uint32_t limite(int balde) { return 16u << balde; } // Limite superior do balde (µs)
+
+  void registrar(uint32_t microssegundos) {
+    int balde = microssegundos <= 16 ? 0 : 28 - __builtin_clz(microssegundos - 1); // teto(log2) - 4
+    if (balde > BALDES_LATENCIA) balde = BALDES_LATENCIA;
+    baldes[balde]++;
+    contagem++;
+    soma += microssegundos;
+  }
+};
+
+Histograma latenciaLoop("loop");            // Trabalho de uma passagem do loop (sem a espera)
+Histograma latenciaPagina("pagina");        // handleRoot
+Histograma latenciaDados("dados");          // handleDados, incluindo o envio da resposta
+Histograma latenciaSensor("sensor");        // Uma leitura de sensor (transação no barramento)
+Histograma latenciaNtp("ntp");              // timeClient.update()
+Histograma latenciaTelegram("telegram");    // bot.sendMessage(), incluindo a conexão TLS
+Histograma latenciaHistorico("historico");  // historico.push(), incluindo a compressão de um bloco cheio
+Histograma* histogramas[] = {&latenciaLoop, &latenciaPagina, &latenciaDados, &latenciaSensor, &latenciaNtp, &latenciaTelegram,
+                             &latenciaHistorico};
+
+// Mede o tempo entre a construção e o fim do escopo (inclusive em retornos antecipados)
+struct Medicao {
+  Histograma& histograma;
+  unsigned long inicio;
+  explicit Medicao(Histograma& histograma) : histograma(histograma), inicio(micros()) {}
+  ~Medicao() { histograma.registrar(micros() - inicio); }
+};
+
+// Registra um temporizador; o primeiro disparo ocorre um período após o registro. Retorna NULL
+// (e avisa no monitor serial) se a tabela já tiver MAX_TEMPORIZADORES.
+Temporizador* agendar(const char* nome, unsigned long periodo, void (*funcao)()) {
+  if (numTemporizadores >= MAX_TEMPORIZADORES) {
+    Serial.printf("Temporizador \"%s\" não registrado: aumente MAX_TEMPORIZADORES\n", nome);
+    return NULL;
+  }
+  Temporizador& temporizador = temporizadores[numTemporizadores++];
+  temporizador = {nome, funcao, periodo, millis() + periodo, 0, 0, 0, 0};
+  return &temporizador;
+}
+
+// Contabiliza um disparo em "agora" e avança o prazo em períodos inteiros (sem deriva acumulada)
+void marcarExecucao(Temporizador& temporizador, unsigned long agora) {
+  long diferenca = (long)(agora - temporizador.prazo);
+  unsigned long atraso = diferenca > 0 ? diferenca : 0;
+  temporizador.execucoes++;
+  temporizador.atrasoTotal += atraso;
+  if (atraso > temporizador.atrasoMaximo) temporizador.atrasoMaximo = atraso;
+  unsigned long pulados = atraso / temporizador.periodo; // Prazos que venceram enquanto este atrasava
+  temporizador.perdidos += pulados;
+  temporizador.prazo += (pulados + 1) * temporizador.periodo;
+}
+
+// Executa os temporizadores do loop cujo prazo venceu
+void executarVencidos(unsigned long agora) {
+  for (int i = 0; i < numTemporizadores; i++) {
+    Temporizador& temporizador = temporizadores[i];
+    if (temporizador.funcao == NULL || (long)(agora - temporizador.prazo) < 0) continue;
+    marcarExecucao(temporizador, agora);
+    temporizador.funcao();
+  }
+}
+
+// Milissegundos até o próximo prazo dos temporizadores do loop, limitado a "limite"
+unsigned long esperaAteProximoPrazo(unsigned long agora, unsigned long limite) {
+  for (int i = 0; i < numTemporizadores; i++) {
+    const Temporizador& temporizador = temporizadores[i];
+    if (temporizador.funcao == NULL) continue;
+    long resta = (long)(temporizador.prazo - agora);
+    if (resta <= 0) return 0;
+    if ((unsigned long)resta < limite) limite = resta;
+  }
+  return limite;
+}
+
+// Pede frequência dinâmica (80-240 MHz) e sono leve automático quando o CPU fica ocioso; o Wi-Fi
+// continua associado (modem sleep entre beacons). O sono leve automático exige tickless idle
+// (CONFIG_FREERTOS_USE_TICKLESS_IDLE), que o núcleo Arduino-ESP32 padrão não habilita: nele,
+// esp_pm_configure recusa o pedido e o sketch tenta só a frequência dinâmica, que por sua vez
+// exige CONFIG_PM_ENABLE. Sem nenhum dos dois, segue em frequência fixa, com o CPU ocioso (sem
+// sono) nas esperas. Mesmo com sono leve, o loop acorda a cada intervaloRede para verificar o
+// servidor web, o que limita a duração de cada sono a ~10 ms; o consumo não foi medido.
+void configurarEnergia() {
+  WiFi.setSleep(true);
+  esp_pm_config_esp32_t configuracao;
+  configuracao.max_freq_mhz = 240;
+  configuracao.min_freq_mhz = 80;
+  configuracao.light_sleep_enable = true;
+  esp_err_t resultado = esp_pm_configure(&configuracao);
+  sonoLeveAtivo = resultado == ESP_OK;
+  if (!sonoLeveAtivo) {
+    configuracao.light_sleep_enable = false;
+    resultado = esp_pm_configure(&configuracao);
+  }
+  frequenciaDinamicaAtiva = resultado == ESP_OK;
+  if (frequenciaDinamicaAtiva) {
+    esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "sensores", &travaFrequencia);
+  }
+  if (!sonoLeveAtivo) {
+    Serial.printf("Sono leve indisponível (sem tickless idle); frequência dinâmica %s (código %d)\n",
+                  frequenciaDinamicaAtiva ? "ativa" : "indisponível", resultado);
+  }
+}
 
 /*
  * SEÇÃO 7: FUNÇÕES AUXILIARES
- * Funções para formatar o tempo e enviar alertas ao Telegram.
+ * Funções para formatar o tempo, avaliar as regras de alerta e enviar alertas ao Telegram. O envio
+ * ocorre em uma tarefa FreeRTOS dedicada: o loop apenas enfileira o alerta (O(1)), e a tarefa faz
+ * a conexão TLS, agrupa rajadas em uma única mensagem e repete envios que falharem com espera
+ * crescente.
  */
-String getFormattedTime() {
-  timeClient.update();                // Atualiza o cliente NTP para obter o tempo atual
-  unsigned long epochTime = timeClient.getEpochTime(); // Obtém o tempo em segundos desde 1970 (Unix epoch)
+// Formata um instante (segundos desde 1970, já no fuso local) como DD/MM/YYYY HH:MM
+void formatarEpoch(unsigned long epochTime, char* destino, size_t tamanho) {
   time_t localTime = epochTime;       // Converte para time_t
-  struct tm* timeinfo = gmtime(&localTime); // Converte para estrutura de tempo em UTC
-  char timeStr[17];                   // Buffer para armazenar a string formatada (DD/MM/YYYY HH:MM)
-  strftime(timeStr, sizeof(timeStr), "%d/%m/%Y %H:%M", timeinfo); // Formata a data e hora
-  return String(timeStr);             // Retorna a string formatada
-}
-
-void sendTelegramAlert(float temperature, float humidity) {
-  unsigned long now = millis();        // Obtém o tempo atual em milissegundos
-  if (WiFi.status() == WL_CONNECTED && (now - lastAlertTime >= ALERT_INTERVAL)) {
-    // Verifica se o Wi-Fi está conectado e se o intervalo mínimo entre alertas foi respeitado
-    String message = "⚠️ ALERTA: Temperatura alta! " + String(temperature, 1) + "°C e Umidade " + String(humidity, 1) + "% em " + getFormattedTime();
-    // Monta a mensagem de alerta com temperatura, umidade e timestamp
+  struct tm timeinfo;
+  gmtime_r(&localTime, &timeinfo);    // Converte para estrutura de tempo em UTC (reentrante)
+  strftime(destino, tamanho, "%d/%m/%Y %H:%M", &timeinfo); // Formata a data e hora
+}
+
+/*
+ * Relógio: o NTP é consultado apenas na sincronização periódica, que ancora o epoch a millis().
+ * Entre sincronizações, epochAtual() é só uma soma, sem rede nem alocação; a formatação em texto
+ * fica para quando uma resposta é serializada. Até a primeira resposta do NTP não há âncora: as
+ * leituras desse período são descartadas, pois teriam instantes fora de ordem com as gravadas.
+ */
+uint32_t epochAncora = 0;             // Epoch (fuso local) obtido na última sincronização
+unsigned long millisAncora = 0;       // millis() no instante da última sincronização
+bool relogioSincronizado = false;     // O NTP já respondeu ao menos uma vez
+uint32_t leiturasSemRelogio = 0;      // Leituras descartadas antes da primeira sincronização
+
+void sincronizarRelogio() {
+  {
+    Medicao medicao(latenciaNtp);
+    timeClient.update();              // Consulta o servidor NTP se o intervalo de atualização venceu
+  }
+  if (!timeClient.isTimeSet()) return; // Sem resposta: getEpochTime() seria só o tempo ligado
+  relogioSincronizado = true;
+  epochAncora = timeClient.getEpochTime(); // Reancora o relógio local
+  millisAncora = millis();
+}
+
+uint32_t epochAtual() {
+  return epochAncora + (millis() - millisAncora) / 1000; // Segundos decorridos desde a âncora
+}
+
+/*
+ * Regras de alerta: cada regra observa uma métrica de um canal e dispara ao cruzar o limiar; só
+ * normaliza depois de voltar além da faixa de histerese, então uma leitura oscilando em torno do
+ * limiar não gera alertas repetidos. Regras de taxa comparam a amostra atual com a de "janela"
+ * segundos atrás no histórico do canal (acesso direto ao RingBuffer), e "duracao" exige que a
+ * condição se mantenha antes do disparo. Cada regra custa O(1) por amostra.
+ */
+const uint8_t METRICA_TEMPERATURA = 0;
+const uint8_t METRICA_UMIDADE = 1;
+const uint8_t REGRA_LIMITE = 0;                 // Compara o valor da amostra com o limiar
+const uint8_t REGRA_TAXA = 1;                   // Compara a variação por minuto com o limiar
+const int MAX_REGRAS = 32;
+
+struct Regra {
+  char nome[24];                      // Texto exibido na mensagem de alerta
+  uint8_t canal;                      // Índice em "canais"
+  uint8_t metrica;                    // METRICA_TEMPERATURA ou METRICA_UMIDADE
+  uint8_t tipo;                       // REGRA_LIMITE ou REGRA_TAXA
+  int8_t sentido;                     // +1: dispara acima do limiar; -1: abaixo
+  int32_t limiar;                     // Centésimos de °C ou %; em REGRA_TAXA, centésimos por minuto
+  int32_t histerese;                  // Quanto o valor precisa voltar além do limiar para normalizar
+  uint32_t janela;                    // REGRA_TAXA: intervalo em que a variação é medida (segundos)
+  uint32_t duracao;                   // Tempo que a condição precisa durar antes do disparo (segundos)
+  bool ativa;                         // Regras inativas não são avaliadas
+};
+
+struct EstadoRegra {
+  bool emCondicao;                    // A condição de disparo vale desde "desde"
+  bool disparada;                     // Alerta enviado e ainda não normalizado
+  uint32_t desde;                     // Instante em que a condição passou a valer
+  uint32_t disparos;                  // Alertas disparados desde a inicialização
+};
+
+// Regras padrão (substituídas pelas gravadas na flash, se houver; alteráveis em /regras)
+Regra regras[MAX_REGRAS] = {
+  {"Temperatura alta", 0, METRICA_TEMPERATURA, REGRA_LIMITE, 1, 2450, 50, 0, 0, true},    // > 24,5 °C, normaliza < 24,0 °C
+  {"Aquecimento rápido", 0, METRICA_TEMPERATURA, REGRA_TAXA, 1, 20, 10, 600, 0, true},    // > 0,2 °C/min em 10 min
+  {"Umidade alta", 0, METRICA_UMIDADE, REGRA_LIMITE, 1, 7000, 500, 0, 300, true},         // > 70 % por 5 min
+};
+int numRegras = 3;
+EstadoRegra estadosRegras[MAX_REGRAS];
+uint32_t avaliacoesRegras = 0;        // Amostras avaliadas
+uint32_t custoRegrasTotal = 0;        // Tempo somado das avaliações (µs)
+uint32_t custoRegrasMaximo = 0;       // Avaliação mais lenta (µs)
+
+// Nomes são escritos sem escape no JSON de /regras: aspas, barras invertidas e caracteres de
+// controle não são aceitos
+bool nomeRegraValido(const char* nome) {
+  for (const char* c = nome; *c; c++) {
+    if (*c == '"' || *c == '\\' || (uint8_t)*c < 0x20) return false;
+  }
+  return true;
+}
+
+struct Alerta {
+  char regra[24];                     // Nome da regra (cópia: a regra pode mudar antes do envio)
+  const char* canal;                  // Nome do canal
+  bool normalizou;                    // false: disparo; true: a condição deixou de valer
+  uint8_t metrica;                    // Métrica da regra
+  uint8_t tipo;                       // Tipo da regra
+  int32_t valor;                      // Valor avaliado (centésimos, ou centésimos por minuto)
+  int32_t limiar;                     // Limiar da regra
+  Amostra amostra;                    // Leitura que mudou o estado da regra
+};
+
+const int TAMANHO_FILA_ALERTAS = 8;             // Alertas pendentes antes de começar a descartar
+const int TENTATIVAS_ALERTA = 4;                // Tentativas de envio por chat
+const unsigned long ESPERA_INICIAL_ALERTA = 2000; // Espera antes da 1ª repetição (dobra a cada falha, ms)
+QueueHandle_t filaAlertas = NULL;               // Fila entre o loop e a tarefa de envio
+volatile unsigned long alertasEnviados = 0;     // Mensagens entregues (por chat)
+volatile unsigned long alertasFalhos = 0;       // Mensagens que esgotaram as tentativas (por chat)
+volatile unsigned long alertasDescartados = 0;  // Alertas perdidos por fila cheia
+
+int32_t valorDaMetrica(const Amostra& amostra, uint8_t metrica) {
+  return metrica == METRICA_UMIDADE ? (int32_t)amostra.umidade : (int32_t)amostra.temperatura;
+}
+
+// Variação por minuto (centésimos) entre a amostra mais recente do canal e a de "janela" segundos
+// atrás, localizada pelo intervalo de leitura; false se o histórico ainda não cobre a janela
+bool taxaDoCanal(const Canal& canal, const Regra& regra, int32_t& taxa) {
+  size_t passos = regra.janela / (intervaloLeitura / 1000);
+  if (passos == 0) passos = 1;
+  if (passos >= canal.historico.size()) return false;
+  const Amostra& atual = canal.historico.back();
+  const Amostra& anterior = canal.historico[canal.historico.size() - 1 - passos];
+  if (atual.epoch <= anterior.epoch) return false;
+  taxa = (valorDaMetrica(atual, regra.metrica) - valorDaMetrica(anterior, regra.metrica)) * 60 /
+         (int32_t)(atual.epoch - anterior.epoch);
+  return true;
+}
+
+// Enfileira a mudança de estado de uma regra, sem acesso à rede
+void enfileirarAlerta(const Regra& regra, const Amostra& amostra, int32_t valor, bool normalizou) {
+  Alerta alerta;
+  memcpy(alerta.regra, regra.nome, sizeof(alerta.regra));
+  alerta.canal = canais[regra.canal].nome;
+  alerta.normalizou = normalizou;
+  alerta.metrica = regra.metrica;
+  alerta.tipo = regra.tipo;
+  alerta.valor = valor;
+  alerta.limiar = regra.limiar;
+  alerta.amostra = amostra;
+  if (xQueueSend(filaAlertas, &alerta, 0) != pdTRUE) { // Não bloqueia: fila cheia descarta
+    alertasDescartados++;
+  }
+}
+
+// Chamado pelo loop a cada leitura válida, depois de registrá-la no histórico do canal
+void avaliarRegras(int indiceCanal, const Amostra& amostra) {
+  unsigned long inicio = micros();
+  const Canal& canal = canais[indiceCanal];
+  for (int i = 0; i < numRegras; i++) {
+    const Regra& regra = regras[i];
+    if (!regra.ativa || regra.canal != indiceCanal) continue;
+    int32_t valor;
+    if (regra.tipo == REGRA_TAXA) {
+      if (!taxaDoCanal(canal, regra, valor)) continue;
+    } else {
+      valor = valorDaMetrica(amostra, regra.metrica);
+    }
+
+    EstadoRegra& estado = estadosRegras[i];
+    if (estado.disparada) { // Normaliza só ao sair da faixa de histerese
+      if (regra.sentido * (valor - regra.limiar) + regra.histerese > 0) continue;
+      estado.disparada = false;
+      estado.emCondicao = false;
+      enfileirarAlerta(regra, amostra, valor, true);
+      continue;
+    }
+    if (regra.sentido * (valor - regra.limiar) <= 0) {
+      estado.emCondicao = false;
+      continue;
+    }
+    if (!estado.emCondicao) {
+      estado.emCondicao = true;
+      estado.desde = amostra.epoch;
+    }
+    if (amostra.epoch - estado.desde >= regra.duracao) {
+      estado.disparada = true;
+      estado.disparos++;
+      enfileirarAlerta(regra, amostra, valor, false);
+    }
+  }
+  uint32_t custo = micros() - inicio;
+  avaliacoesRegras++;
+  custoRegrasTotal += custo;
+  if (custo > custoRegrasMaximo) custoRegrasMaximo = custo;
+}
+
+// Texto de um valor de regra: "24.50°C", "70.00%" ou "+0.20°C/min"
+String textoValor(uint8_t metrica, uint8_t tipo, int32_t valor) {
+  String texto = (tipo == REGRA_TAXA && valor >= 0) ? "+" : "";
+  texto += String(valor / 100.0f, 2);
+  texto += metrica == METRICA_UMIDADE ? "%" : "°C";
+  if (tipo == REGRA_TAXA) texto += "/min";
+  return texto;
+}
+
+String mensagemAlerta(const Alerta& alerta) {
+  char quando[17];
+  formatarEpoch(alerta.amostra.epoch, quando, sizeof(quando));
+  String linha = alerta.normalizou ? "✅ NORMALIZADO: " : "⚠️ ALERTA: ";
+  linha += String(alerta.regra) + " [" + alerta.canal + "] " + textoValor(alerta.metrica, alerta.tipo, alerta.valor);
+  if (!alerta.normalizou) linha += " (limiar " + textoValor(alerta.metrica, alerta.tipo, alerta.limiar) + ")";
+  linha += ". Temperatura " + String(alerta.amostra.temperatura / 100.0f, 1) + "°C e Umidade " +
+           String(alerta.amostra.umidade / 100.0f, 1) + "% em " + quando;
+  return linha;
+}
+
+// Envia a mensagem a um chat, repetindo com espera exponencial em caso de falha
+bool enviarComRepeticao(const String& id, const String& message) {
+  unsigned long espera = ESPERA_INICIAL_ALERTA;
+  for (int tentativa = 1; tentativa <= TENTATIVAS_ALERTA; tentativa++) {
+    if (WiFi.status() == WL_CONNECTED) {
+      Medicao medicao(latenciaTelegram);
+      if (bot.sendMessage(id, message, "")) return true;
+    }
+    if (tentativa < TENTATIVAS_ALERTA) {
+      vTaskDelay(pdMS_TO_TICKS(espera)); // Aguarda sem ocupar a CPU; novos alertas ficam na fila
+      espera *= 2;
+    }
+  }
+  return false;
+}
+
+void tarefaAlertas(void*) { // A tarefa não usa parâmetro: lê tudo de filaAlertas
+  unsigned long descartadosInformados = 0;
+  Alerta alerta;
+  for (;;) {
+    xQueueReceive(filaAlertas, &alerta, portMAX_DELAY); // Dorme até chegar um alerta
+
+    // Agrupa tudo o que acumulou na fila em uma única mensagem, uma linha por alerta
+    String message = mensagemAlerta(alerta);
+    while (xQueueReceive(filaAlertas, &alerta, 0) == pdTRUE) {
+      message += "\n" + mensagemAlerta(alerta);
+    }
+    // Um único cliente TLS atende todos os chats, reaproveitando a conexão enquanto ela seguir aberta
     for (String id : chatIds) {       // Itera sobre os IDs de chats/grupos
-      if (bot.sendMessage(id, message, "")) {
+      if (enviarComRepeticao(id, message)) {
+        alertasEnviados++;
         Serial.println("Alerta enviado para o Telegram (ID: " + id + ")!"); // Log de sucesso
       } else {
+        alertasFalhos++;
         Serial.println("Falha ao enviar alerta para o Telegram (ID: " + id + ")."); // Log de falha
       }
     }
-    lastAlertTime = now;              // Atualiza o timestamp do último alerta
+
+    unsigned long descartados = alertasDescartados;
+    if (descartados != descartadosInformados) { // Informa perdas desde o último relatório
+      Serial.printf("Alertas descartados (fila cheia): %lu\n", descartados);
+      descartadosInformados = descartados;
+    }
+  }
+}
+
+/*
+ * SEÇÃO 8: ARMAZENAMENTO PERSISTENTE
+ * Grava o histórico na flash (LittleFS) para que sobreviva a reinicializações e quedas de energia.
+ * As leituras vão para segmentos de escrita apenas por acréscimo, em blocos de tamanho fixo com
+ * CRC, gravados a cada AMOSTRAS_POR_BLOCO leituras para limitar o desgaste da flash. As janelas
+ * fechadas de 1 h e 1 dia são acrescentadas a arquivos próprios no momento em que fecham.
+ * Na inicialização, apenas o final desses arquivos é lido para reconstruir a RAM.
+ */
+const char* DIRETORIO_HISTORICO = "/hist";       // Diretório dos arquivos do histórico
+const char* ARQUIVO_HORAS = "/hist/horas.agr";   // Janelas de 1 h fechadas
+const char* ARQUIVO_DIAS = "/hist/dias.agr";     // Janelas de 1 dia fechadas
+const char* ARQUIVO_REGRAS = "/regras.cfg";      // Regras de alerta configuradas em /regras
+const uint32_t MAGICA_BLOCO = 0x314E4F4D;        // "MON1": identifica um bloco de leituras
+const int AMOSTRAS_POR_BLOCO = 32;               // Leituras por gravação (~5 min a cada 10 s)
+const uint32_t BLOCOS_POR_SEGMENTO = 64;         // Blocos por segmento (~5,7 horas, ~17 KB)
+const uint32_t MAX_SEGMENTOS = 48;               // Segmentos mantidos (~11 dias); o mais antigo é apagado
+
+struct BlocoHistorico {
+  uint32_t magica;                               // MAGICA_BLOCO
+  uint32_t crc;                                  // CRC32 das amostras do bloco
+  Amostra amostras[AMOSTRAS_POR_BLOCO];          // Leituras, da mais antiga à mais recente
+};
+
+struct RegistroAgregado {
+  Agregado agregado;                             // Janela fechada
+  uint32_t crc;                                  // CRC32 do agregado
+};
+
+struct RegistroRegra {
+  Regra regra;                                   // Configuração da regra
+  uint32_t crc;                                  // CRC32 da regra
+};
+
+bool armazenamentoAtivo = false;                 // LittleFS montado com sucesso
+uint32_t primeiroSegmento = 1;                   // Número do segmento mais antigo na flash
+uint32_t segmentoAtual = 1;                      // Número do segmento em gravação
+uint32_t blocosNoSegmento = 0;                   // Blocos já gravados no segmento atual
+BlocoHistorico blocoPendente;                    // Leituras ainda não gravadas
+int amostrasPendentes = 0;                       // Quantidade de leituras em blocoPendente
+
+uint32_t calcularCrc(const void* dados, size_t tamanho) {
+  return crc32_le(0, (const uint8_t*)dados, tamanho);
+}
+
+void caminhoSegmento(uint32_t numero, char* destino, size_t tamanho) {
+  snprintf(destino, tamanho, "%s/%08lu.seg", DIRETORIO_HISTORICO, (unsigned long)numero);
+}
+
+// Apaga os segmentos mais antigos até restarem MAX_SEGMENTOS, contando o segmento em gravação
+void descartarSegmentosAntigos() {
+  while (segmentoAtual - primeiroSegmento >= MAX_SEGMENTOS) {
+    char antigo[32];
+    caminhoSegmento(primeiroSegmento++, antigo, sizeof(antigo));
+    LittleFS.remove(antigo);
+  }
+}
+
+void gravarBloco() {
+  if (blocosNoSegmento == BLOCOS_POR_SEGMENTO) { // Segmento cheio: passa para o próximo
+    segmentoAtual++;
+    blocosNoSegmento = 0;
+    descartarSegmentosAntigos();
+  }
+  blocoPendente.magica = MAGICA_BLOCO;
+  blocoPendente.crc = calcularCrc(blocoPendente.amostras, sizeof(blocoPendente.amostras));
+
+  char caminho[32];
+  caminhoSegmento(segmentoAtual, caminho, sizeof(caminho));
+  File arquivo = LittleFS.open(caminho, "a"); // Apenas acrescenta ao final do segmento
+  if (arquivo) {
+    arquivo.write((const uint8_t*)&blocoPendente, sizeof(blocoPendente));
+    arquivo.close();
+    blocosNoSegmento++;
+  } else {
+    Serial.println("Falha ao gravar bloco do histórico");
+  }
+}
+
+// Acrescenta uma janela fechada ao seu arquivo; quando o arquivo passa de 4x a capacidade do
+// nível, ele é reescrito a partir da RAM com apenas as janelas que o nível ainda guarda
+template <size_t N>
+void gravarAgregado(const char* caminho, const NivelAgregacao<N>& nivel, const Agregado& agregado) {
+  RegistroAgregado registro = {agregado, calcularCrc(&agregado, sizeof(agregado))};
+  File arquivo = LittleFS.open(caminho, "a");
+  if (!arquivo) return;
+  arquivo.write((const uint8_t*)&registro, sizeof(registro));
+  size_t tamanho = arquivo.size();
+  arquivo.close();
+
+  if (tamanho < 4 * N * sizeof(RegistroAgregado)) return;
+  char temporario[40];
+  snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+  arquivo = LittleFS.open(temporario, "w");
+  if (!arquivo) return;
+  for (const Agregado& fechado : nivel.fechados) {
+    registro = {fechado, calcularCrc(&fechado, sizeof(fechado))};
+    arquivo.write((const uint8_t*)&registro, sizeof(registro));
+  }
+  arquivo.close();
+  LittleFS.remove(caminho);
+  LittleFS.rename(temporario, caminho);
+}
+
+// Carrega as últimas N janelas válidas de um arquivo de agregados para o nível; retorna o início
+// da janela mais recente carregada (0 se nenhuma)
+template <size_t N>
+uint32_t carregarAgregados(const char* caminho, NivelAgregacao<N>& nivel) {
+  File arquivo = LittleFS.open(caminho, "r");
+  if (!arquivo) return 0;
+  size_t registros = arquivo.size() / sizeof(RegistroAgregado);
+  if (registros > N) arquivo.seek((registros - N) * sizeof(RegistroAgregado)); // Só o final
+  RegistroAgregado registro;
+  uint32_t ultimo = 0;
+  while (arquivo.read((uint8_t*)&registro, sizeof(registro)) == sizeof(registro)) {
+    if (registro.crc != calcularCrc(&registro.agregado, sizeof(registro.agregado))) continue;
+    nivel.fechados.push(registro.agregado);
+    ultimo = registro.agregado.epoch;
+  }
+  arquivo.close();
+  return ultimo;
+}
+
+// Reescreve o arquivo de regras (raro: apenas quando /regras altera a configuração)
+void salvarRegras() {
+  if (!armazenamentoAtivo) return;
+  char temporario[24];
+  snprintf(temporario, sizeof(temporario), "%s.tmp", ARQUIVO_REGRAS);
+  File arquivo = LittleFS.open(temporario, "w");
+  if (!arquivo) return;
+  for (int i = 0; i < numRegras; i++) {
+    RegistroRegra registro = {regras[i], calcularCrc(&regras[i], sizeof(Regra))};
+    arquivo.write((const uint8_t*)&registro, sizeof(registro));
+  }
+  arquivo.close();
+  LittleFS.remove(ARQUIVO_REGRAS);
+  LittleFS.rename(temporario, ARQUIVO_REGRAS);
+}
+
+// Substitui as regras padrão pelas gravadas, se o arquivo existir e contiver regras válidas
+// (um arquivo vazio significa que todas as regras foram removidas)
+void carregarRegras() {
+  if (!armazenamentoAtivo) return;
+  File arquivo = LittleFS.open(ARQUIVO_REGRAS, "r");
+  if (!arquivo) return;
+  size_t registros = arquivo.size() / sizeof(RegistroRegra);
+  RegistroRegra registro;
+  int validas = 0;
+  while (validas < MAX_REGRAS && arquivo.read((uint8_t*)&registro, sizeof(registro)) == sizeof(registro)) {
+    if (registro.crc != calcularCrc(&registro.regra, sizeof(registro.regra))) continue;
+    if (registro.regra.canal >= NUM_CANAIS) registro.regra.ativa = false; // Canal removido do código
+    registro.regra.nome[sizeof(registro.regra.nome) - 1] = '\0';
+    if (!nomeRegraValido(registro.regra.nome)) strcpy(registro.regra.nome, "Regra"); // Gravada antes da validação
+    regras[validas++] = registro.regra;
+  }
+  arquivo.close();
+  if (validas > 0 || registros == 0) numRegras = validas;
+  Serial.printf("Regras de alerta: %d\n", numRegras);
+}
+
+// Registra uma leitura válida: histórico em RAM, níveis de agregação e, se "gravar", a flash.
+// As janelas de hora e dia fechadas por ela são gravadas imediatamente.
+void registrarAmostra(const Amostra& amostra, bool gravar) {
+  {
+    Medicao medicao(latenciaHistorico);
+    historico.push(amostra);
+  }
+  Agregado hora, dia;
+  int fechados = agregarAmostra(amostra, hora, dia);
+  if (!armazenamentoAtivo) return;
+  if (fechados & FECHOU_HORA) gravarAgregado(ARQUIVO_HORAS, nivelHora, hora);
+  if (fechados & FECHOU_DIA) gravarAgregado(ARQUIVO_DIAS, nivelDia, dia);
+  if (gravar) {
+    blocoPendente.amostras[amostrasPendentes++] = amostra;
+    if (amostrasPendentes == AMOSTRAS_POR_BLOCO) { // Lote completo: uma única gravação na flash
+      gravarBloco();
+      amostrasPendentes = 0;
+    }
+  }
+}
+
+// Monta o LittleFS e reconstrói o histórico em RAM e os níveis de agregação a partir da flash
+void recuperarHistorico() {
+  unsigned long inicio = millis();
+  if (!LittleFS.begin(true)) { // Formata a partição se ela ainda não contiver um sistema de arquivos
+    Serial.println("LittleFS indisponível: histórico apenas em RAM");
+    return;
+  }
+  LittleFS.mkdir(DIRETORIO_HISTORICO);
+
+  // Descobre a faixa de segmentos existentes pelo nome dos arquivos
+  uint32_t menor = 0, maior = 0;
+  File diretorio = LittleFS.open(DIRETORIO_HISTORICO);
+  for (File arquivo = diretorio.openNextFile(); arquivo; arquivo = diretorio.openNextFile()) {
+    const char* nome = strrchr(arquivo.name(), '/'); // Algumas versões retornam o caminho completo
+    nome = nome ? nome + 1 : arquivo.name();
+    if (strstr(nome, ".seg") == NULL) continue;
+    uint32_t numero = strtoul(nome, NULL, 10);
+    if (numero == 0) continue;
+    if (menor == 0 || numero < menor) menor = numero;
+    if (numero > maior) maior = numero;
+  }
+  diretorio.close();
+
+  // Janelas de 1 h e 1 dia já fechadas; a cascata não deve fechá-las de novo
+  uint32_t ultimaHora = carregarAgregados(ARQUIVO_HORAS, nivelHora);
+  uint32_t ultimoDia = carregarAgregados(ARQUIVO_DIAS, nivelDia);
+  if (ultimaHora != 0) nivelHora.piso = ultimaHora + nivelHora.resolucao;
+  if (ultimoDia != 0) nivelDia.piso = ultimoDia + nivelDia.resolucao;
+  Agregado ignorado;
+  for (const Agregado& hora : nivelHora.fechados) { // Horas do dia em andamento reabrem a janela do dia
+    nivelDia.acumular(hora, ignorado);
+  }
+
+  // Localiza, de trás para frente, o primeiro bloco necessário para encher o histórico em RAM:
+  // soma o tamanho comprimido estimado de cada bloco até esgotar a arena, para não reaplicar
+  // leituras que seriam descartadas em seguida
+  uint32_t recuperadas = 0;
+  if (maior != 0) {
+    BlocoHistorico lido;
+    uint32_t bitsLivres = historico.bitsUteis();
+    uint32_t segmento = maior, bloco = 0;
+    bool cheio = false;
+    for (;;) {
+      char caminho[32];
+      caminhoSegmento(segmento, caminho, sizeof(caminho));
+      File arquivo = LittleFS.open(caminho, "r");
+      bloco = arquivo ? arquivo.size() / sizeof(BlocoHistorico) : 0;
+      while (bloco > 0) {
+        arquivo.seek((bloco - 1) * sizeof(BlocoHistorico));
+        if (arquivo.read((uint8_t*)&lido, sizeof(lido)) == sizeof(lido) && lido.magica == MAGICA_BLOCO) {
+          uint32_t bits = historico.bitsEstimados(lido.amostras, AMOSTRAS_POR_BLOCO);
+          if (bits > bitsLivres) {
+            cheio = true;
+            break;
+          }
+          bitsLivres -= bits;
+        }
+        bloco--;
+      }
+      if (arquivo) arquivo.close();
+      if (cheio || segmento == menor) break;
+      segmento--;
+    }
+
+    // Reaplica os blocos válidos em ordem cronológica
+    for (; segmento <= maior; segmento++, bloco = 0) {
+      char caminho[32];
+      caminhoSegmento(segmento, caminho, sizeof(caminho));
+      File arquivo = LittleFS.open(caminho, "r");
+      if (!arquivo) continue;
+      arquivo.seek(bloco * sizeof(BlocoHistorico));
+      while (arquivo.read((uint8_t*)&lido, sizeof(lido)) == sizeof(lido)) {
+        if (lido.magica != MAGICA_BLOCO || lido.crc != calcularCrc(lido.amostras, sizeof(lido.amostras))) continue;
+        for (const Amostra& amostra : lido.amostras) registrarAmostra(amostra, false);
+        recuperadas += AMOSTRAS_POR_BLOCO;
+      }
+      arquivo.close();
+    }
+    // Continua o último segmento se ele não estiver cheio nem terminar em um bloco cortado;
+    // assim reinicializações frequentes não criam um segmento por execução
+    char caminho[32];
+    caminhoSegmento(maior, caminho, sizeof(caminho));
+    File ultimo = LittleFS.open(caminho, "r");
+    size_t bytes = ultimo ? ultimo.size() : 0;
+    if (ultimo) ultimo.close();
+    primeiroSegmento = menor;
+    if (bytes % sizeof(BlocoHistorico) == 0 && bytes / sizeof(BlocoHistorico) < BLOCOS_POR_SEGMENTO) {
+      segmentoAtual = maior;
+      blocosNoSegmento = bytes / sizeof(BlocoHistorico);
+    } else {
+      segmentoAtual = maior + 1; // Novas gravações começam em um segmento novo
+      blocosNoSegmento = 0;
+    }
+    descartarSegmentosAntigos();
   }
+  armazenamentoAtivo = true;
+  Serial.printf("Histórico recuperado: %lu leituras, %u horas, %u dias em %lu ms\n",
+                (unsigned long)recuperadas, (unsigned)nivelHora.fechados.size(),
+                (unsigned)nivelDia.fechados.size(), millis() - inicio);
 }
 
 /*
- * SEÇÃO 8: INTERFACE WEB
- * Define a página web servida pelo ESP32, incluindo HTML, CSS e JavaScript para exibir
- * temperatura, umidade, gráficos e logs.
+ * SEÇÃO 9: INTERFACE WEB
+ * Serve a página web do ESP32 (HTML, CSS e JavaScript para exibir temperatura, umidade,
+ * gráficos e logs). A página fica em pagina.html e é comprimida em tempo de compilação por
+ * gerar_pagina.py, que gera pagina_html_gz.h: o conteúdo gzip é enviado direto da flash, sem
+ * cópia para a RAM, e o navegador revalida pelo ETag, recebendo 304 se nada mudou.
  */
 void handleRoot() {
-  server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Define tamanho dinâmico para a resposta HTTP
-  String html = R"rawliteral(
-    <!DOCTYPE html>
-    <html lang="pt-BR">
-    <head>
-      <meta charset="UTF-8" /> <!-- Define codificação de caracteres -->
-      <meta name="viewport" content="width=device-width, initial-scale=1.0" /> <!-- Configura responsividade -->
-      <title>Monitoramento ESP32</title> <!-- Título da página -->
-      <style>
-        body {
-          font-family: Arial, sans-serif; /* Fonte padrão */
-          background: white; /* Fundo branco */
-          color: #333; /* Cor do texto */
-          padding: 30px; /* Espaçamento interno */
-          text-align: center; /* Centraliza texto */
-        }
-        .container {
-          background: #f5f5f5; /* Fundo do contêiner */
-          border-radius: 10px; /* Bordas arredondadas */
-          padding: 30px; /* Espaçamento interno */
-          margin-bottom: 30px; /* Margem inferior */
-          display: inline-block; /* Contêiner ajustado ao conteúdo */
-          box-shadow: 0 2px 4px rgba(0,0,0,0.1); /* Sombra leve */
-        }
-        h1 { font-size: 2em; color: #333; } /* Estilo do título principal */
-        h2 { color: #333; margin-top: 40px; } /* Estilo dos subtítulos */
-        p { font-size: 1.3em; color: #333; } /* Estilo dos parágrafos */
-        .chart-container {
-          background: #f5f5f5; /* Fundo do gráfico */
-          border-radius: 10px; /* Bordas arredondadas */
-          padding: 20px; /* Espaçamento interno */
-          margin: 20px auto; /* Centraliza com margem */
-          box-shadow: 0 2px 4px rgba(0,0,0,0.1); /* Sombra leve */
-          width: 600px; /* Largura fixa */
-          text-align: center; /* Centraliza texto */
-        }
-        .hourly-center {
-          margin: 20px auto; /* Centraliza horizontalmente */
-          display: block; /* Exibe como bloco */
-          text-align: center; /* Centraliza texto */
-          width: 600px; /* Largura fixa */
-        }
-        .log-container {
-          background: #f5f5f5; /* Fundo do log */
-          border-radius: 10px; /* Bordas arredondadas */
-          padding: 20px; /* Espaçamento interno */
-          max-width: 600px; /* Largura máxima */
-          margin: 20px auto; /* Centraliza com margem */
-          max-height: 200px; /* Altura máxima */
-          overflow-y: auto; /* Barra de rolagem vertical */
-          text-align: left; /* Alinhamento à esquerda */
-          box-shadow: 0 2px 4px rgba(0,0,0,0.1); /* Sombra leve */
-        }
-        .log-entry { font-size: 1.1em; margin: 5px 0; color: #333; } /* Estilo das entradas de log */
-      </style>
-    </head>
-    <body>
-      <div class="container">
-        <h1>Monitoramento de Ambiente</h1> <!-- Título da página -->
-        <p id="temp">🌡️ Temperatura Atual: <strong>--°C</strong></p> <!-- Exibe temperatura atual -->
-        <p id="umid">💧 Umidade Atual: <strong>--%</strong></p> <!-- Exibe umidade atual -->
-      </div>
-
-      <h2>📈 Histórico de Leituras (Últimos 100 segundos)</h2> <!-- Título do gráfico de leituras -->
-      <div class="chart-container">
-        <canvas id="lineChart" width="600" height="400"></canvas> <!-- Canvas para gráfico de linhas -->
-      </div>
-
-      <h2>📅 Histórico por Hora (Últimas 10 horas)</h2> <!-- Título do gráfico de médias horárias -->
-      <div class="chart-container hourly-center">
-        <canvas id="hourlyChart" width="600" height="400"></canvas> <!-- Canvas para gráfico horário -->
-      </div>
-
-      <h2>📜 Log de Leituras</h2> <!-- Título do log -->
-      <div class="log-container" id="log">
-        <!-- Log será preenchido via JavaScript -->
-      </div>
-
-      <script src="https://cdn.jsdelivr.net/npm/chart.js"></script> <!-- Inclui biblioteca Chart.js -->
-      <script>
-        let lineChart, hourlyChart; // Variáveis para armazenar instâncias dos gráficos
-
-        async function atualizarDados() {
-          const resposta = await fetch("/dados"); // Faz requisição ao endpoint /dados
-          const json = await resposta.json(); // Converte resposta para JSON
-          const temperaturas = json.temperaturas; // Array de temperaturas
-          const umidades = json.umidades; // Array de umidades
-          const mediasTempHoras = json.mediasTempHoras; // Array de médias horárias de temperatura
-          const mediasUmidHoras = json.mediasUmidHoras; // Array de médias horárias de umidade
-          const labelsHoras = json.horas; // Array de timestamps horários
-          const logs = json.logs; // Array de logs
-
-          // Atualiza temperatura e umidade atuais na página
-          document.getElementById("temp").innerHTML = "🌡️ Temperatura Atual: <strong>" + temperaturas[temperaturas.length - 1].toFixed(1) + "°C</strong>";
-          document.getElementById("umid").innerHTML = "💧 Umidade Atual: <strong>" + umidades[umidades.length - 1].toFixed(1) + "%</strong>";
-
-          // Atualiza o contêiner de logs
-          const logContainer = document.getElementById("log");
-          logContainer.innerHTML = ""; // Limpa logs anteriores
-          logs.forEach(log => {
-            const div = document.createElement("div"); // Cria elemento para cada log
-            div.className = "log-entry"; // Aplica estilo
-            div.textContent = log; // Define texto do log
-            logContainer.appendChild(div); // Adiciona ao contêiner
-          });
-
-          // Gera rótulos para o gráfico de leituras (números sequenciais)
-          const labels = temperaturas.map((_, i) => (i + 1).toString());
-
-          // Destroi gráficos existentes para evitar sobreposição
-          if (lineChart) lineChart.destroy();
-          if (hourlyChart) hourlyChart.destroy();
-
-          // Cria gráfico de linhas para histórico de leituras
-          lineChart = new Chart(document.getElementById("lineChart"), {
-            type: "line", // Tipo de gráfico
-            data: {
-              labels: labels, // Rótulos do eixo X
-              datasets: [
-                { label: "Temperatura (°C)", data: temperaturas, yAxisID: 'y1', borderColor: "blue", fill: false }, // Dados de temperatura
-                { label: "Umidade (%)", data: umidades, yAxisID: 'y2', borderColor: "red", fill: false } // Dados de umidade
-              ]
-            },
-            options: {
-              responsive: false, // Desativa responsividade para tamanho fixo
-              scales: {
-                y1: { type: 'linear', position: 'left', title: { display: true, text: 'Temperatura (°C)' } }, // Eixo Y para temperatura
-                y2: { type: 'linear', position: 'right', title: { display: true, text: 'Umidade (%)' }, grid: { drawOnChartArea: false } } // Eixo Y para umidade
-              }
-            }
-          });
-
-          // Cria gráfico de linhas para médias horárias
-          hourlyChart = new Chart(document.getElementById("hourlyChart"), {
-            type: "line", // Tipo de gráfico
-            data: {
-              labels: labelsHoras, // Rótulos do eixo X (horas)
-              datasets: [
-                { label: "Temperatura Média (°C)", data: mediasTempHoras, yAxisID: 'y1', borderColor: "blue", fill: false }, // Médias de temperatura
-                { label: "Umidade Média (%)", data: mediasUmidHoras, yAxisID: 'y2', borderColor: "red", fill: false } // Médias de umidade
-              ]
-            },
-            options: {
-              responsive: false, // Desativa responsividade para tamanho fixo
-              scales: {
-                x: { title: { display: true, text: 'Hora' } }, // Título do eixo X
-                y1: { type: 'linear', position: 'left', title: { display: true, text: 'Temperatura (°C)' } }, // Eixo Y para temperatura
-                y2: { type: 'linear', position: 'right', title: { display: true, text: 'Umidade (%)' }, grid: { drawOnChartArea: false } } // Eixo Y para umidade
-              }
-            }
-          });
-        }
+  Medicao medicao(latenciaPagina);
+  server.sendHeader("ETag", PAGINA_HTML_ETAG);   // Identifica a versão da página
+  server.sendHeader("Cache-Control", "no-cache"); // Permite cache, mas exige revalidação
 
-        setInterval(atualizarDados, 10000); // Atualiza dados a cada 10 segundos
-        window.onload = atualizarDados; // Executa ao carregar a página
-      </script>
-    </body>
-    </html>
-  )rawliteral";
+  String etagCliente = server.header("If-None-Match"); // ETag guardado pelo navegador (se houver)
+  if (etagCliente.length() > 0 && strstr(etagCliente.c_str(), PAGINA_HTML_ETAG) != NULL) {
+    server.send(304); // Página inalterada: o navegador usa a cópia em cache
+    return;
+  }
 
-  server.send(200, "text/html", html); // Envia a página HTML como resposta HTTP
+  // Todos os navegadores atuais aceitam gzip; o ESP32 não guarda versão descomprimida
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, "text/html", (PGM_P)PAGINA_HTML_GZ, PAGINA_HTML_GZ_TAMANHO); // Envia da flash
 }
 
 /*
- * SEÇÃO 9: ENDPOINT JSON
+ * SEÇÃO 10: ENDPOINT JSON
  * Fornece dados em formato JSON para a interface web, incluindo temperaturas, umidades,
- * médias horárias e logs.
+ * médias horárias e logs. A resposta é serializada em fluxo: cada bloco é enviado ao cliente
+ * assim que o buffer fixo enche (transferência chunked), sem montar Strings no heap.
+ */
+const size_t TAMANHO_BLOCO_JSON = 256;  // Tamanho do buffer de envio da resposta JSON (bytes)
+
+// Destino padrão dos blocos: a resposta HTTP em andamento, como um chunk
+void enviarAoCliente(const char* dados, size_t tamanho) {
+  server.sendContent(dados, tamanho);
+}
+
+struct EscritorJson {
+  char buffer[TAMANHO_BLOCO_JSON];      // Buffer fixo onde a resposta é montada antes do envio
+  size_t usado = 0;                     // Quantidade de bytes ocupados no buffer
+  size_t enviados = 0;                  // Bytes já entregues ao destino
+  void (*saida)(const char*, size_t) = enviarAoCliente; // Para onde vai cada bloco cheio
+
+  void descarregar() {
+    if (usado > 0) {
+      saida(buffer, usado); // Entrega o bloco acumulado ao destino
+      enviados += usado;
+      usado = 0;
+    }
+  }
+
+  void escrever(const char* texto, size_t tamanho) {
+    while (tamanho > 0) {
+      if (usado == TAMANHO_BLOCO_JSON) descarregar(); // Buffer cheio: envia antes de continuar
+      size_t parte = TAMANHO_BLOCO_JSON - usado;
+      if (parte > tamanho) parte = tamanho;
+      memcpy(buffer + usado, texto, parte); // Copia o trecho que cabe no buffer
+      usado += parte;
+      texto += parte;
+      tamanho -= parte;
+    }
+  }
+
+  void escrever(const char* texto) {
+    escrever(texto, strlen(texto));
+  }
+
+  void escreverInteiro(unsigned long valor) {
+    char texto[12];
+    char* fim = texto + sizeof(texto);
+    char* p = fim;
+    do {
+      *--p = '0' + (valor % 10);
+      valor /= 10;
+    } while (valor > 0);
+    escrever(p, fim - p);
+  }
+
+  // Escreve um número com casas decimais fixas, no mesmo formato de String(valor, casas),
+  // usando apenas aritmética inteira (arredondamento para o par em empates, como o printf).
+  void escreverFixo(float valor, unsigned int casas) {
+    static const uint32_t escalas[] = {1, 10, 100, 1000};
+    if (isnan(valor)) { escrever("nan"); return; }
+    if (isinf(valor)) { escrever(valor < 0 ? "-inf" : "inf"); return; }
+    if (casas > 3) casas = 3;
+    double escalado = fabs((double)valor) * escalas[casas]; // Exato: float (24 bits) x escala cabe no double
+    if (escalado >= 4000000000.0) { // Fora da faixa de 32 bits: recorre ao snprintf em buffer local
+      char texto[48];
+      escrever(texto, snprintf(texto, sizeof(texto), "%.*f", casas, (double)valor));
+      return;
+    }
+    double parteInteira = floor(escalado);
+    double fracao = escalado - parteInteira;
+    uint32_t n = (uint32_t)parteInteira;
+    if (fracao > 0.5 || (fracao == 0.5 && (n & 1))) n++; // Arredonda; empate vai para o par
+    escreverDecimal(n, casas, signbit(valor)); // Mantém o sinal, inclusive em "-0.00"
+  }
+
+  // Escreve um valor em centésimos (ex.: 2450 -> "24.50"); com uma casa, arredonda o centésimo
+  void escreverCentesimos(int32_t valor, unsigned int casas) {
+    bool negativo = valor < 0;
+    uint32_t n = negativo ? -(uint32_t)valor : (uint32_t)valor;
+    if (casas < 2) {
+      n = (n + 5) / 10; // Arredonda para décimos
+      casas = 1;
+    }
+    escreverDecimal(n, casas, negativo);
+  }
+
+  // Escreve o inteiro n como número com "casas" dígitos após o ponto
+  void escreverDecimal(uint32_t n, unsigned int casas, bool negativo) {
+    char texto[16];
+    char* fim = texto + sizeof(texto);
+    char* p = fim;
+    for (unsigned int i = 0; i < casas; i++) { // Dígitos decimais, do menos significativo
+      *--p = '0' + (n % 10);
+      n /= 10;
+    }
+    if (casas > 0) *--p = '.';
+    do { // Parte inteira (ao menos um dígito)
+      *--p = '0' + (n % 10);
+      n /= 10;
+    } while (n > 0);
+    if (negativo) *--p = '-';
+    escrever(p, fim - p);
+  }
+};
+
+// Valores (em centésimos) escritos por escreverSerie, para cada tipo de registro armazenado
+int32_t temperaturaDe(const Amostra& amostra) { return amostra.temperatura; }
+int32_t umidadeDe(const Amostra& amostra) { return amostra.umidade; }
+int32_t temperaturaDe(const Agregado& agregado) { return lroundf(agregado.temperatura.media); }
+int32_t umidadeDe(const Agregado& agregado) { return lroundf(agregado.umidade.media); }
+
+// Escreve o valor extraído por "campo" dos "quantidade" registros mais recentes do buffer, do mais
+// antigo ao mais recente, com duas casas como String(float), separados por vírgula
+template <typename Buffer>
+void escreverSerie(EscritorJson& json, const Buffer& buffer, size_t quantidade, int32_t (*campo)(const typename Buffer::Item&)) {
+  auto it = buffer.ultimos(quantidade);
+  for (size_t i = 0; i < quantidade; i++, ++it) {
+    json.escreverCentesimos(campo(*it), 2);
+    if (i < quantidade - 1) json.escrever(","); // Adiciona vírgula, exceto na última entrada
+  }
+}
+
+// Escreve os instantes das "quantidade" médias mais recentes como "HH:MM", entre aspas
+void escreverArrayHoras(EscritorJson& json, size_t quantidade) {
+  char dataHora[17];
+  auto it = nivelMinuto.fechados.ultimos(quantidade);
+  for (size_t i = 0; i < quantidade; i++, ++it) {
+    formatarEpoch(it->epoch, dataHora, sizeof(dataHora)); // DD/MM/YYYY HH:MM
+    json.escrever("\"");
+    json.escrever(dataHora + 11, 5); // Apenas HH:MM
+    json.escrever("\"");
+    if (i < quantidade - 1) json.escrever(","); // Adiciona vírgula, exceto na última entrada
+  }
+}
+
+// Escreve as entradas de log das "quantidade" leituras mais recentes, montando o texto neste momento
+void escreverArrayLogs(EscritorJson& json, size_t quantidade) {
+  char dataHora[17];
+  auto it = historico.ultimos(quantidade);
+  for (size_t i = 0; i < quantidade; i++, ++it) {
+    formatarEpoch(it->epoch, dataHora, sizeof(dataHora));
+    json.escrever("\"");
+    json.escrever(dataHora);
+    json.escrever(" Temperatura ");
+    json.escreverCentesimos(it->temperatura, 1);
+    json.escrever("°C / Umidade ");
+    json.escreverCentesimos(it->umidade, 1);
+    json.escrever("%\"");
+    if (i < quantidade - 1) json.escrever(","); // Adiciona vírgula, exceto na última entrada
+  }
+}
+
+// Quantos dos registros exibíveis têm sequência maior que "desde" (ainda não vistos pelo cliente)
+size_t registrosNovos(uint32_t seqAtual, uint32_t desde, size_t total) {
+  uint32_t novos = seqAtual - desde;
+  return novos < total ? novos : total;
+}
+
+size_t menor(size_t a, size_t b) {
+  return a < b ? a : b;
+}
+
+// Lê um cursor de sequência da query string; cursores à frente da sequência atual vêm de uma
+// execução anterior do ESP32 e são tratados como 0 (reenvia tudo)
+uint32_t lerCursor(const char* nome, uint32_t seqAtual) {
+  uint32_t desde = strtoul(server.arg(nome).c_str(), NULL, 10); // Argumento ausente vira 0
+  return desde > seqAtual ? 0 : desde;
+}
+
+/*
+ * Formato binário (formato=bin), little-endian: um cabeçalho seguido de nLeituras e nHoras
+ * registros Amostra de 8 bytes {uint32 epoch, int16 temperatura, uint16 umidade}, valores em
+ * centésimos, do mais antigo ao mais recente. A sequência de cada registro é seq - n + 1 + posição.
+ */
+struct CabecalhoDadosBinario {
+  uint16_t versao;      // Versão do formato (2)
+  uint16_t nLeituras;   // Quantidade de leituras enviadas
+  uint16_t nHoras;      // Quantidade de médias horárias enviadas
+  uint16_t reservado;   // Alinhamento (sempre 0)
+  uint32_t idBoot;      // Identificador da execução atual do ESP32
+  uint32_t seq;         // Sequência da leitura mais recente
+  uint32_t seqHoras;    // Sequência da média horária mais recente
+};
+
+template <typename Serie>
+void enviarAmostrasBinario(EscritorJson& saida, const Serie& serie, size_t quantidade) {
+  for (auto it = serie.ultimos(quantidade); it != serie.end(); ++it) {
+    saida.escrever((const char*)&*it, sizeof(Amostra)); // Registro decodificado no formato de 8 bytes
+  }
+}
+
+template <size_t N>
+void enviarMediasBinario(EscritorJson& saida, const RingBuffer<Agregado, N>& buffer, size_t quantidade) {
+  for (auto it = buffer.ultimos(quantidade); it != buffer.end(); ++it) {
+    Amostra media = it->media(); // Média da janela no formato de amostra
+    saida.escrever((const char*)&media, sizeof(Amostra));
+  }
+}
+
+/*
+ * GET /dados                     -> histórico recente (formato original)
+ * GET /dados?since=N&sinceHoras=M -> apenas leituras/logs com sequência > N e médias com sequência > M,
+ *                                   mais os cursores atuais ("seq", "seqHoras") e o "boot"
+ * Acrescentar formato=bin retorna o mesmo conteúdo no formato binário compacto.
  */
+// Escreve o objeto JSON de /dados com as "novas*" entradas mais recentes de cada série; no modo
+// incremental, inclui os cursores para a próxima consulta
+void escreverDadosJson(EscritorJson& json, bool incremental, size_t novasLeituras, size_t novosLogs, size_t novasHoras) {
+  json.escrever("{ ");
+  if (incremental) { // Cursores para a próxima consulta incremental
+    json.escrever("\"boot\": ");
+    json.escreverInteiro(idBoot);
+    json.escrever(", \"seq\": ");
+    json.escreverInteiro(historico.total());
+    json.escrever(", \"seqHoras\": ");
+    json.escreverInteiro(nivelMinuto.fechados.total());
+    json.escrever(", ");
+  }
+  json.escrever("\"temperaturas\": ["); // Inicia array de temperaturas
+  escreverSerie(json, historico, novasLeituras, temperaturaDe);
+  json.escrever("], \"umidades\": ["); // Inicia array de umidades
+  escreverSerie(json, historico, novasLeituras, umidadeDe);
+  json.escrever("], \"mediasTempHoras\": ["); // Inicia array de médias horárias de temperatura
+  escreverSerie(json, nivelMinuto.fechados, novasHoras, temperaturaDe);
+  json.escrever("], \"mediasUmidHoras\": ["); // Inicia array de médias horárias de umidade
+  escreverSerie(json, nivelMinuto.fechados, novasHoras, umidadeDe);
+  json.escrever("], \"horas\": ["); // Inicia array de timestamps horários
+  escreverArrayHoras(json, novasHoras);
+  json.escrever("], \"logs\": ["); // Inicia array de logs
+  escreverArrayLogs(json, novosLogs);
+  json.escrever("] }"); // Fecha o objeto JSON
+}
+
+uint32_t respostasDados = 0;          // Respostas de /dados enviadas
+uint32_t bytesDados = 0;              // Bytes somados dessas respostas
+uint32_t ultimaRespostaDados = 0;     // Tamanho da resposta mais recente (bytes)
+
 void handleDados() {
-  String json = "{ \"temperaturas\": ["; // Inicia o objeto JSON com array de temperaturas
-  for (int i = 0; i < totalLeituras; i++) {
-    int idx = (indiceLeitura + i) % maxLeituras; // Calcula índice no buffer circular
-    json += String(historicoTemperatura[idx]); // Adiciona temperatura
-    if (i < totalLeituras - 1) json += ","; // Adiciona vírgula, exceto na última entrada
-  }
-  json += "], \"umidades\": ["; // Inicia array de umidades
-  for (int i = 0; i < totalLeituras; i++) {
-    int idx = (indiceLeitura + i) % maxLeituras; // Calcula índice no buffer circular
-    json += String(historicoUmidade[idx]); // Adiciona umidade
-    if (i < totalLeituras - 1) json += ","; // Adiciona vírgula, exceto na última entrada
-  }
-  json += "], \"mediasTempHoras\": ["; // Inicia array de médias horárias de temperatura
-  for (int i = 0; i < totalHoras; i++) {
-    int idx = (indiceHora + i) % maxHoras; // Calcula índice no buffer circular
-    json += String(mediasTemperatura[idx]); // Adiciona média de temperatura
-    if (i < totalHoras - 1) json += ","; // Adiciona vírgula, exceto na última entrada
-  }
-  json += "], \"mediasUmidHoras\": ["; // Inicia array de médias horárias de umidade
-  for (int i = 0; i < totalHoras; i++) {
-    int idx = (indiceHora + i) % maxHoras; // Calcula índice no buffer circular
-    json += String(mediasUmidade[idx]); // Adiciona média de umidade
-    if (i < totalHoras - 1) json += ","; // Adiciona vírgula, exceto na última entrada
-  }
-  json += "], \"horas\": ["; // Inicia array de timestamps horários
-  for (int i = 0; i < totalHoras; i++) {
-    int idx = (indiceHora + i) % maxHoras; // Calcula índice no buffer circular
-    json += "\"" + horas[idx] + "\""; // Adiciona timestamp formatado
-    if (i < totalHoras - 1) json += ","; // Adiciona vírgula, exceto na última entrada
-  }
-  json += "], \"logs\": ["; // Inicia array de logs
-  for (int i = 0; i < totalLog; i++) {
-    int idx = (indiceLog + i) % maxLog; // Calcula índice no buffer circular
-    json += "\"" + logEntradas[idx] + "\""; // Adiciona entrada de log
-    if (i < totalLog - 1) json += ","; // Adiciona vírgula, exceto na última entrada
-  }
-  json += "] }"; // Fecha o objeto JSON
-
-  server.send(200, "application/json", json); // Envia a resposta JSON
+  Medicao medicao(latenciaDados);
+  bool incremental = server.hasArg("since"); // Modo incremental: cliente informa o que já tem
+  size_t novasLeituras = menor(historico.size(), maxLeituras);
+  size_t novosLogs = menor(historico.size(), maxLog);
+  size_t novasHoras = menor(nivelMinuto.fechados.size(), maxHoras);
+  if (incremental) {
+    uint32_t desde = lerCursor("since", historico.total());
+    uint32_t desdeHoras = lerCursor("sinceHoras", nivelMinuto.fechados.total());
+    novasLeituras = registrosNovos(historico.total(), desde, novasLeituras);
+    novosLogs = registrosNovos(historico.total(), desde, novosLogs); // Logs são as próprias leituras
+    novasHoras = registrosNovos(nivelMinuto.fechados.total(), desdeHoras, novasHoras);
+  }
+  bool binario = server.arg("formato") == "bin";
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Tamanho desconhecido: resposta em chunks
+  server.send(200, binario ? "application/octet-stream" : "application/json", ""); // Apenas cabeçalhos
+
+  EscritorJson json;                               // Buffer de envio na pilha (sem heap)
+  if (binario) {
+    CabecalhoDadosBinario cabecalho = {2, (uint16_t)novasLeituras, (uint16_t)novasHoras, 0,
+                                       idBoot, historico.total(), nivelMinuto.fechados.total()};
+    json.escrever((const char*)&cabecalho, sizeof(cabecalho));
+    enviarAmostrasBinario(json, historico, novasLeituras);
+    enviarMediasBinario(json, nivelMinuto.fechados, novasHoras);
+  } else {
+    escreverDadosJson(json, incremental, novasLeituras, novosLogs, novasHoras);
+  }
+
+  json.descarregar();         // Envia o último bloco pendente
+  server.sendContent("", 0);  // Chunk vazio: encerra a transferência
+  respostasDados++;
+  bytesDados += json.enviados;
+  ultimaRespostaDados = json.enviados;
+}
+
+// Escreve "nome": {n, min, max, media, desvio} de uma estatística (null se não houver amostras)
+void escreverEstatistica(EscritorJson& json, const char* nome, const Estatistica& estatistica) {
+  json.escrever("\"");
+  json.escrever(nome);
+  json.escrever("\": ");
+  if (estatistica.n == 0) {
+    json.escrever("null");
+    return;
+  }
+  json.escrever("{ \"n\": ");
+  json.escreverInteiro(estatistica.n);
+  json.escrever(", \"min\": ");
+  json.escreverCentesimos(estatistica.minimo, 2);
+  json.escrever(", \"max\": ");
+  json.escreverCentesimos(estatistica.maximo, 2);
+  json.escrever(", \"media\": ");
+  json.escreverFixo(estatistica.media / 100.0f, 2);
+  json.escrever(", \"desvio\": ");
+  json.escreverFixo(sqrtf(estatistica.variancia()) / 100.0f, 2);
+  json.escrever(" }");
 }
 
 /*
- * SEÇÃO 10: CONFIGURAÇÃO INICIAL
- * Inicializa o hardware, conecta ao Wi-Fi, configura o sensor, sincroniza o tempo e inicia o servidor web.
+ * GET /resumo?horas=N (ou ?minutos=N) -> contagem, mínimo, máximo, média e desvio padrão de
+ * temperatura e umidade no período, calculados a partir dos níveis de agregação, sem percorrer
+ * as leituras brutas. Sem argumentos, resume a última hora. "inicio" é o início da janela de
+ * agregação mais antiga incluída.
+ */
+void handleResumo() {
+  uint32_t segundos = 3600;
+  if (server.hasArg("horas")) segundos = strtoul(server.arg("horas").c_str(), NULL, 10) * 3600;
+  else if (server.hasArg("minutos")) segundos = strtoul(server.arg("minutos").c_str(), NULL, 10) * 60;
+
+  Agregado total;
+  uint32_t resolucao;
+  const char* nivel = resumirJanela(epochAtual(), segundos, total, resolucao);
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Tamanho desconhecido: resposta em chunks
+  server.send(200, "application/json", "");       // Envia apenas os cabeçalhos HTTP
+  EscritorJson json;
+  json.escrever("{ \"nivel\": \"");
+  json.escrever(nivel);
+  json.escrever("\", \"resolucao\": ");
+  json.escreverInteiro(resolucao);
+  json.escrever(", \"inicio\": ");
+  json.escreverInteiro(total.epoch);
+  json.escrever(", ");
+  escreverEstatistica(json, "temperatura", total.temperatura);
+  json.escrever(", ");
+  escreverEstatistica(json, "umidade", total.umidade);
+  json.escrever(" }");
+  json.descarregar();
+  server.sendContent("", 0);
+}
+
+/*
+ * GET /agenda -> temporizadores com execuções, atraso médio e máximo de disparo (ms) e prazos
+ * perdidos, além de quantas vezes o loop acordou desde a inicialização.
+ */
+void handleAgenda() {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Tamanho desconhecido: resposta em chunks
+  server.send(200, "application/json", "");       // Envia apenas os cabeçalhos HTTP
+  EscritorJson json;
+  json.escrever("{ \"ativoMs\": ");
+  json.escreverInteiro(millis());
+  json.escrever(", \"despertares\": ");
+  json.escreverInteiro(despertares);
+  json.escrever(", \"sonoLeve\": ");
+  json.escrever(sonoLeveAtivo ? "true" : "false");
+  json.escrever(", \"frequenciaDinamica\": ");
+  json.escrever(frequenciaDinamicaAtiva ? "true" : "false");
+  json.escrever(", \"temporizadores\": [");
+  for (int i = 0; i < numTemporizadores; i++) {
+    const Temporizador& temporizador = temporizadores[i];
+    if (i > 0) json.escrever(", ");
+    json.escrever("{ \"nome\": \"");
+    json.escrever(temporizador.nome);
+    json.escrever("\", \"periodo\": ");
+    json.escreverInteiro(temporizador.periodo);
+    json.escrever(", \"execucoes\": ");
+    json.escreverInteiro(temporizador.execucoes);
+    json.escrever(", \"atrasoMedio\": ");
+    json.escreverFixo(temporizador.execucoes > 0 ? (float)temporizador.atrasoTotal / temporizador.execucoes : 0, 1);
+    json.escrever(", \"atrasoMaximo\": ");
+    json.escreverInteiro(temporizador.atrasoMaximo);
+    json.escrever(", \"perdidos\": ");
+    json.escreverInteiro(temporizador.perdidos);
+    json.escrever(" }");
+  }
+  json.escrever("] }");
+  json.descarregar();
+  server.sendContent("", 0);
+}
+
+// Lê um valor em °C ou % (ex.: "24.5") da query string como centésimos
+int32_t lerCentesimos(const char* nome) {
+  return paraCentesimos(strtof(server.arg(nome).c_str(), NULL));
+}
+
+// Aplica à regra os argumentos presentes na requisição; retorna a mensagem de erro ou NULL
+const char* configurarRegra(Regra& regra) {
+  if (server.hasArg("nome")) {
+    String nome = server.arg("nome");
+    if (!nomeRegraValido(nome.c_str())) return "nome não pode conter aspas, barra invertida nem caracteres de controle";
+    strncpy(regra.nome, nome.c_str(), sizeof(regra.nome) - 1);
+    regra.nome[sizeof(regra.nome) - 1] = '\0';
+  }
+  if (server.hasArg("canal")) {
+    long canal = server.arg("canal").toInt();
+    if (canal < 0 || canal >= NUM_CANAIS) return "Canal inexistente";
+    regra.canal = canal;
+  }
+  if (server.hasArg("metrica")) {
+    String metrica = server.arg("metrica");
+    if (metrica == "temperatura") regra.metrica = METRICA_TEMPERATURA;
+    else if (metrica == "umidade") regra.metrica = METRICA_UMIDADE;
+    else return "metrica deve ser temperatura ou umidade";
+  }
+  if (server.hasArg("tipo")) {
+    String tipo = server.arg("tipo");
+    if (tipo == "limite") regra.tipo = REGRA_LIMITE;
+    else if (tipo == "taxa") regra.tipo = REGRA_TAXA;
+    else return "tipo deve ser limite ou taxa";
+  }
+  if (server.hasArg("sentido")) {
+    String sentido = server.arg("sentido");
+    if (sentido == "acima") regra.sentido = 1;
+    else if (sentido == "abaixo") regra.sentido = -1;
+    else return "sentido deve ser acima ou abaixo";
+  }
+  if (server.hasArg("limiar")) regra.limiar = lerCentesimos("limiar");
+  if (server.hasArg("histerese")) regra.histerese = lerCentesimos("histerese");
+  if (server.hasArg("janela")) regra.janela = strtoul(server.arg("janela").c_str(), NULL, 10);
+  if (server.hasArg("duracao")) regra.duracao = strtoul(server.arg("duracao").c_str(), NULL, 10);
+  if (server.hasArg("ativa")) regra.ativa = server.arg("ativa") != "0";
+  if (regra.histerese < 0) return "histerese deve ser positiva";
+  if (regra.tipo == REGRA_TAXA && regra.janela / (intervaloLeitura / 1000) >= capacidadeCanal) {
+    return "janela maior que o histórico do canal";
+  }
+  return NULL;
+}
+
+void escreverRegra(EscritorJson& json, int indice) {
+  const Regra& regra = regras[indice];
+  const EstadoRegra& estado = estadosRegras[indice];
+  json.escrever("{ \"id\": ");
+  json.escreverInteiro(indice);
+  json.escrever(", \"nome\": \"");
+  json.escrever(regra.nome); // Sem aspas nem barras: validado por nomeRegraValido()
+  json.escrever("\", \"canal\": ");
+  json.escreverInteiro(regra.canal);
+  json.escrever(regra.metrica == METRICA_UMIDADE ? ", \"metrica\": \"umidade\"" : ", \"metrica\": \"temperatura\"");
+  json.escrever(regra.tipo == REGRA_TAXA ? ", \"tipo\": \"taxa\"" : ", \"tipo\": \"limite\"");
+  json.escrever(regra.sentido < 0 ? ", \"sentido\": \"abaixo\"" : ", \"sentido\": \"acima\"");
+  json.escrever(", \"limiar\": ");
+  json.escreverCentesimos(regra.limiar, 2);
+  json.escrever(", \"histerese\": ");
+  json.escreverCentesimos(regra.histerese, 2);
+  json.escrever(", \"janela\": ");
+  json.escreverInteiro(regra.janela);
+  json.escrever(", \"duracao\": ");
+  json.escreverInteiro(regra.duracao);
+  json.escrever(regra.ativa ? ", \"ativa\": true" : ", \"ativa\": false");
+  json.escrever(estado.disparada ? ", \"disparada\": true" : ", \"disparada\": false");
+  json.escrever(", \"disparos\": ");
+  json.escreverInteiro(estado.disparos);
+  json.escrever(" }");
+}
+
+// Responde com as regras de alerta, seu estado e o custo de avaliação por amostra (µs)
+void responderRegras() {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Tamanho desconhecido: resposta em chunks
+  server.send(200, "application/json", "");       // Envia apenas os cabeçalhos HTTP
+  EscritorJson json;
+  json.escrever("{ \"avaliacoes\": ");
+  json.escreverInteiro(avaliacoesRegras);
+  json.escrever(", \"custoMedioUs\": ");
+  json.escreverFixo(avaliacoesRegras > 0 ? (float)custoRegrasTotal / avaliacoesRegras : 0, 1);
+  json.escrever(", \"custoMaximoUs\": ");
+  json.escreverInteiro(custoRegrasMaximo);
+  json.escrever(", \"alertasDescartados\": ");
+  json.escreverInteiro(alertasDescartados);
+  json.escrever(", \"regras\": [");
+  for (int i = 0; i < numRegras; i++) {
+    if (i > 0) json.escrever(", ");
+    escreverRegra(json, i);
+  }
+  json.escrever("] }");
+  json.descarregar();
+  server.sendContent("", 0);
+}
+
+/*
+ * GET /regras -> regras de alerta, com estado e custo de avaliação por amostra (µs). Somente
+ * leitura: "id" ou "remover" em GET recebem 405, para que um link, a pré-carga do navegador ou um
+ * rastreador não alterem as regras.
+ */
+void handleRegras() {
+  if (server.hasArg("id") || server.hasArg("remover")) {
+    server.sendHeader("Allow", "POST");
+    server.send(405, "text/plain", "Use POST para alterar regras");
+    return;
+  }
+  responderRegras();
+}
+
+/*
+ * POST /regras com id=N&campo=valor... -> altera a regra N (ou cria, se N for a próxima posição)
+ *   e a reinicia; campos: nome, canal, metrica (temperatura|umidade), tipo (limite|taxa),
+ *   sentido (acima|abaixo), limiar e histerese (°C ou %; em taxa, por minuto), janela e duracao
+ *   (segundos), ativa (0|1). Campos ausentes mantêm o valor atual.
+ * POST /regras com remover=N -> remove a regra N.
+ * Os campos vêm no formulário ou na URL; as alterações são gravadas na flash e a resposta é a
+ * lista de regras, como em GET.
+ */
+void handleAlterarRegras() {
+  if (server.hasArg("remover")) {
+    long indice = server.arg("remover").toInt();
+    if (indice < 0 || indice >= numRegras) {
+      server.send(404, "text/plain", "Regra inexistente");
+      return;
+    }
+    for (int i = indice; i < numRegras - 1; i++) {
+      regras[i] = regras[i + 1];
+      estadosRegras[i] = estadosRegras[i + 1];
+    }
+    numRegras--;
+    salvarRegras();
+  } else if (server.hasArg("id")) {
+    long indice = server.arg("id").toInt();
+    if (indice < 0 || indice > numRegras || indice >= MAX_REGRAS) {
+      server.send(404, "text/plain", "Regra inexistente");
+      return;
+    }
+    Regra regra = indice < numRegras ? regras[indice]
+                                     : Regra{"Regra", CANAL_PRINCIPAL, METRICA_TEMPERATURA, REGRA_LIMITE, 1, 0, 0, 0, 0, true};
+    const char* erro = configurarRegra(regra);
+    if (erro) {
+      server.send(400, "text/plain", erro);
+      return;
+    }
+    regras[indice] = regra;
+    estadosRegras[indice] = EstadoRegra(); // Reavalia do zero com a nova configuração
+    if (indice == numRegras) numRegras++;
+    salvarRegras();
+  } else {
+    server.send(400, "text/plain", "Informe id ou remover");
+    return;
+  }
+  responderRegras();
+}
+
+// Escreve uma métrica de uma linha no formato de texto do Prometheus: nome{rotulo="valor"} numero
+void escreverMetrica(EscritorJson& json, const char* nome, const char* rotulo, const char* valorRotulo, uint32_t valor) {
+  json.escrever(nome);
+  if (rotulo) {
+    json.escrever("{");
+    json.escrever(rotulo);
+    json.escrever("=\"");
+    json.escrever(valorRotulo);
+    json.escrever("\"}");
+  }
+  json.escrever(" ");
+  json.escreverInteiro(valor);
+  json.escrever("\n");
+}
+
+void escreverCabecalhoMetrica(EscritorJson& json, const char* nome, const char* tipo, const char* ajuda) {
+  json.escrever("# HELP ");
+  json.escrever(nome);
+  json.escrever(" ");
+  json.escrever(ajuda);
+  json.escrever("\n# TYPE ");
+  json.escrever(nome);
+  json.escrever(" ");
+  json.escrever(tipo);
+  json.escrever("\n");
+}
+
+// Escreve microssegundos como segundos com seis casas (ex.: 1234567 -> "1.234567")
+void escreverSegundos(EscritorJson& json, uint64_t microssegundos) {
+  json.escreverInteiro((unsigned long)(microssegundos / 1000000));
+  char fracao[8];
+  uint32_t resto = microssegundos % 1000000;
+  for (int i = 6; i >= 1; i--, resto /= 10) fracao[i] = '0' + resto % 10;
+  fracao[0] = '.';
+  json.escrever(fracao, 7);
+}
+
+void escreverHistograma(EscritorJson& json, const Histograma& histograma) {
+  uint32_t acumulado = 0;
+  for (int balde = 0; balde <= BALDES_LATENCIA; balde++) {
+    acumulado += histograma.baldes[balde];
+    json.escrever("monitor_latencia_segundos_bucket{operacao=\"");
+    json.escrever(histograma.nome);
+    json.escrever("\",le=\"");
+    if (balde < BALDES_LATENCIA) escreverSegundos(json, Histograma::limite(balde));
+    else json.escrever("+Inf");
+    json.escrever("\"} ");
+    json.escreverInteiro(acumulado);
+    json.escrever("\n");
+  }
+  json.escrever("monitor_latencia_segundos_sum{operacao=\"");
+  json.escrever(histograma.nome);
+  json.escrever("\"} ");
+  escreverSegundos(json, histograma.soma);
+  json.escrever("\n");
+  escreverMetrica(json, "monitor_latencia_segundos_count", "operacao", histograma.nome, histograma.contagem);
+}
+
+/*
+ * GET /metrics -> métricas no formato de texto do Prometheus: histogramas de latência, leituras
+ * inválidas por canal, alertas, prazos perdidos, tamanho das respostas de /dados, compressão do
+ * histórico e memória livre.
+ */
+void handleMetrics() {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Tamanho desconhecido: resposta em chunks
+  server.send(200, "text/plain; version=0.0.4", ""); // Envia apenas os cabeçalhos HTTP
+  EscritorJson json;
+
+  escreverCabecalhoMetrica(json, "monitor_latencia_segundos", "histogram", "Duracao das operacoes instrumentadas.");
+  for (const Histograma* histograma : histogramas) escreverHistograma(json, *histograma);
+
+  escreverCabecalhoMetrica(json, "monitor_leituras_total", "counter", "Leituras validas por canal.");
+  for (const Canal& canal : canais) escreverMetrica(json, "monitor_leituras_total", "canal", canal.nome, canal.historico.total());
+  escreverCabecalhoMetrica(json, "monitor_leituras_invalidas_total", "counter", "Leituras invalidas (NaN) por canal.");
+  for (const Canal& canal : canais) escreverMetrica(json, "monitor_leituras_invalidas_total", "canal", canal.nome, canal.falhas);
+  escreverCabecalhoMetrica(json, "monitor_leituras_descartadas_total", "counter", "Leituras perdidas por fila cheia.");
+  escreverMetrica(json, "monitor_leituras_descartadas_total", NULL, NULL, leiturasDescartadas);
+  escreverCabecalhoMetrica(json, "monitor_leituras_sem_relogio_total", "counter", "Leituras descartadas antes da primeira resposta do NTP.");
+  escreverMetrica(json, "monitor_leituras_sem_relogio_total", NULL, NULL, leiturasSemRelogio);
+
+  escreverCabecalhoMetrica(json, "monitor_alertas_total", "counter", "Mensagens de alerta por resultado.");
+  escreverMetrica(json, "monitor_alertas_total", "resultado", "enviado", alertasEnviados);
+  escreverMetrica(json, "monitor_alertas_total", "resultado", "falho", alertasFalhos);
+  escreverMetrica(json, "monitor_alertas_total", "resultado", "descartado", alertasDescartados);
+
+  escreverCabecalhoMetrica(json, "monitor_prazos_perdidos_total", "counter", "Prazos pulados por temporizador.");
+  for (int i = 0; i < numTemporizadores; i++) {
+    escreverMetrica(json, "monitor_prazos_perdidos_total", "temporizador", temporizadores[i].nome, temporizadores[i].perdidos);
+  }
+
+  escreverCabecalhoMetrica(json, "monitor_dados_respostas_total", "counter", "Respostas de /dados.");
+  escreverMetrica(json, "monitor_dados_respostas_total", NULL, NULL, respostasDados);
+  escreverCabecalhoMetrica(json, "monitor_dados_bytes_total", "counter", "Bytes enviados em respostas de /dados.");
+  escreverMetrica(json, "monitor_dados_bytes_total", NULL, NULL, bytesDados);
+  escreverCabecalhoMetrica(json, "monitor_dados_ultima_resposta_bytes", "gauge", "Tamanho da resposta mais recente de /dados.");
+  escreverMetrica(json, "monitor_dados_ultima_resposta_bytes", NULL, NULL, ultimaRespostaDados);
+
+  escreverCabecalhoMetrica(json, "monitor_historico_leituras", "gauge", "Leituras no historico comprimido em RAM.");
+  escreverMetrica(json, "monitor_historico_leituras", NULL, NULL, historico.size());
+  escreverCabecalhoMetrica(json, "monitor_historico_bytes", "gauge", "Bytes ocupados pelos blocos comprimidos.");
+  escreverMetrica(json, "monitor_historico_bytes", NULL, NULL, historico.bitsSelados() / 8);
+  escreverCabecalhoMetrica(json, "monitor_historico_bits_por_leitura", "gauge", "Tamanho medio de uma leitura comprimida.");
+  json.escrever("monitor_historico_bits_por_leitura ");
+  json.escreverCentesimos(historico.centesimosDeBitPorAmostra(), 2);
+  json.escrever("\n");
+
+  escreverCabecalhoMetrica(json, "monitor_heap_livre_bytes", "gauge", "Heap livre.");
+  escreverMetrica(json, "monitor_heap_livre_bytes", NULL, NULL, ESP.getFreeHeap());
+  escreverCabecalhoMetrica(json, "monitor_heap_minimo_bytes", "gauge", "Menor heap livre desde a inicializacao.");
+  escreverMetrica(json, "monitor_heap_minimo_bytes", NULL, NULL, ESP.getMinFreeHeap());
+  escreverCabecalhoMetrica(json, "monitor_heap_maior_bloco_bytes", "gauge", "Maior bloco livre do heap (fragmentacao).");
+  escreverMetrica(json, "monitor_heap_maior_bloco_bytes", NULL, NULL, heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+  escreverCabecalhoMetrica(json, "monitor_despertares_total", "counter", "Passagens pelo loop.");
+  escreverMetrica(json, "monitor_despertares_total", NULL, NULL, despertares);
+  escreverCabecalhoMetrica(json, "monitor_ativo_segundos", "gauge", "Tempo desde a inicializacao.");
+  escreverMetrica(json, "monitor_ativo_segundos", NULL, NULL, millis() / 1000);
+
+  json.descarregar();
+  server.sendContent("", 0);
+}
+
+/*
+ * SEÇÃO 11: CANAL DE EVENTOS (SSE)
+ * Em /stream, o navegador mantém uma conexão aberta (Server-Sent Events) e o loop envia cada nova
+ * leitura uma única vez a todos os assinantes, sem novas conexões por atualização. O envio nunca
+ * bloqueia: cada assinante tem um buffer próprio de tamanho fixo, esvaziado com send() não
+ * bloqueante; um cliente lento demais para acompanhar é desconectado quando o buffer enche.
+ */
+const int MAX_ASSINANTES = 4;                    // Conexões /stream simultâneas
+const size_t BUFFER_ASSINANTE = 3072;            // Bytes pendentes por assinante antes de desconectá-lo
+const size_t TAMANHO_EVENTO = 1536;              // Evento completo no pior caso (-40,00 °C, 100,00 %): ~1,1 KB
+const unsigned long INTERVALO_PULSO = 15000;     // Comentário periódico que detecta conexões mortas (ms)
+
+struct Assinante {
+  WiFiClient cliente;                            // Conexão mantida após o handler retornar
+  bool ativo;                                    // Slot em uso
+  size_t pendentes;                              // Bytes aguardando envio em "buffer"
+  char buffer[BUFFER_ASSINANTE];                 // Dados ainda não aceitos pelo socket
+};
+
+Assinante assinantes[MAX_ASSINANTES];
+char evento[TAMANHO_EVENTO];                     // Evento em montagem (compartilhado por todos)
+size_t tamanhoEvento = 0;
+bool eventoTransbordou = false;                  // O evento em montagem não coube em "evento"
+uint32_t seqPublicada = 0;                       // Última leitura enviada aos assinantes
+uint32_t seqHorasPublicada = 0;                  // Última média enviada aos assinantes
+
+// Destino do EscritorJson ao montar um evento: acumula em "evento"
+void acumularEvento(const char* dados, size_t tamanho) {
+  if (tamanhoEvento + tamanho > TAMANHO_EVENTO) {
+    eventoTransbordou = true;
+    return;
+  }
+  memcpy(evento + tamanhoEvento, dados, tamanho);
+  tamanhoEvento += tamanho;
+}
+
+void desconectarAssinante(Assinante& assinante) {
+  assinante.cliente.stop();
+  assinante.ativo = false;
+  assinante.pendentes = 0;
+}
+
+// Envia o que o socket aceitar agora, sem esperar; erros de conexão desconectam o assinante
+void esvaziarAssinante(Assinante& assinante) {
+  if (assinante.pendentes == 0) return;
+  int enviados = send(assinante.cliente.fd(), assinante.buffer, assinante.pendentes, MSG_DONTWAIT);
+  if (enviados < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) desconectarAssinante(assinante);
+    return;
+  }
+  assinante.pendentes -= enviados;
+  memmove(assinante.buffer, assinante.buffer + enviados, assinante.pendentes);
+}
+
+// Enfileira os mesmos bytes para todos os assinantes; quem não tiver espaço é desconectado
+void difundir(const char* dados, size_t tamanho) {
+  for (Assinante& assinante : assinantes) {
+    if (!assinante.ativo) continue;
+    if (assinante.pendentes + tamanho > BUFFER_ASSINANTE) {
+      Serial.println("Assinante /stream lento desconectado");
+      desconectarAssinante(assinante);
+      continue;
+    }
+    memcpy(assinante.buffer + assinante.pendentes, dados, tamanho);
+    assinante.pendentes += tamanho;
+    esvaziarAssinante(assinante);
+  }
+}
+
+bool haAssinantes() {
+  for (const Assinante& assinante : assinantes) {
+    if (assinante.ativo) return true;
+  }
+  return false;
+}
+
+// Chamado pelo loop após cada leitura: publica as leituras e médias ainda não enviadas como um
+// evento "amostra", com o mesmo conteúdo de /dados?since=...
+void publicarAmostras() {
+  uint32_t desde = seqPublicada;
+  uint32_t desdeHoras = seqHorasPublicada;
+  seqPublicada = historico.total();
+  seqHorasPublicada = nivelMinuto.fechados.total();
+  if (!haAssinantes() || desde == seqPublicada) return;
+
+  size_t novasLeituras = registrosNovos(seqPublicada, desde, menor(historico.size(), maxLeituras));
+  size_t novasHoras = registrosNovos(seqHorasPublicada, desdeHoras, menor(nivelMinuto.fechados.size(), maxHoras));
+  tamanhoEvento = 0;
+  eventoTransbordou = false;
+  EscritorJson json;
+  json.saida = acumularEvento;
+  json.escrever("event: amostra\ndata: ");
+  escreverDadosJson(json, true, novasLeituras, menor(novasLeituras, maxLog), novasHoras);
+  json.escrever("\n\n");
+  json.descarregar();
+  if (eventoTransbordou) { // Nunca envia JSON cortado: a página recupera a lacuna por /dados
+    Serial.println("Evento /stream maior que TAMANHO_EVENTO descartado");
+    return;
+  }
+  difundir(evento, tamanhoEvento);
+}
+
+// Chamado a cada passagem do loop: continua envios pendentes
+void atenderAssinantes() {
+  for (Assinante& assinante : assinantes) {
+    if (assinante.ativo) esvaziarAssinante(assinante);
+  }
+}
+
+// Temporizador (INTERVALO_PULSO): descarta conexões fechadas e mantém as demais vivas
+void pulsarAssinantes() {
+  for (Assinante& assinante : assinantes) {
+    if (assinante.ativo && !assinante.cliente.connected()) desconectarAssinante(assinante);
+  }
+  difundir(": pulso\n\n", 9); // Comentário SSE: ignorado pelo navegador, mantém a conexão viva
+}
+
+void handleStream() {
+  for (Assinante& assinante : assinantes) {
+    if (assinante.ativo) continue;
+    assinante.cliente = server.client(); // Cópia da conexão: continua aberta após o handler
+    assinante.ativo = true;
+    assinante.pendentes = 0;
+    const char* cabecalho = "HTTP/1.1 200 OK\r\n"
+                            "Content-Type: text/event-stream\r\n"
+                            "Cache-Control: no-cache\r\n"
+                            "Connection: keep-alive\r\n\r\n"
+                            "retry: 3000\n\n"; // Reconexão automática do navegador após 3 s
+    size_t tamanho = strlen(cabecalho);
+    memcpy(assinante.buffer, cabecalho, tamanho);
+    assinante.pendentes = tamanho;
+    esvaziarAssinante(assinante);
+    return;
+  }
+  server.send(503, "text/plain", "Limite de conexões /stream atingido");
+}
+
+/*
+ * SEÇÃO 12: EXPORTAÇÃO POR INTERVALO
+ * GET /export?from=A&to=B&format=csv|ndjson|bin envia todas as leituras com epoch entre A e B
+ * (inclusive). O início é localizado por busca binária: primeiro entre os segmentos da flash,
+ * pela primeira leitura de cada um, depois entre os blocos do segmento; sem flash, direto no
+ * histórico em RAM. A resposta é produzida pelo loop, no máximo AMOSTRAS_POR_PASSAGEM leituras
+ * por passagem, em um buffer fixo enviado com send() não bloqueante (como o /stream), então uma
+ * exportação de dias nunca fica inteira na RAM nem segura o loop. As leituras mais novas que a
+ * flash (lote ainda não gravado) vêm do histórico em RAM. Uma exportação por vez.
+ */
+const uint8_t FORMATO_CSV = 0;                   // epoch,temperatura,umidade por linha
+const uint8_t FORMATO_NDJSON = 1;                // Um objeto JSON por linha
+const uint8_t FORMATO_BINARIO = 2;               // Registros Amostra de 8 bytes, little-endian
+const uint8_t FASE_FLASH = 0;                    // Percorrendo os blocos gravados
+const uint8_t FASE_RAM = 1;                      // Percorrendo o histórico em RAM
+const uint8_t FASE_FIM = 2;                      // Nada mais a enviar
+const int AMOSTRAS_POR_PASSAGEM = 32;            // Leituras formatadas por passagem do loop
+const size_t BUFFER_EXPORTACAO = 2048;           // Comporta uma passagem no formato mais longo (NDJSON)
+const size_t MAXIMO_LINHA_EXPORTACAO = 64;       // Maior leitura formatada (NDJSON com todos os dígitos)
+const unsigned long ESPERA_MAXIMA_EXPORTACAO = 30000; // Cliente parado por mais tempo é desconectado (ms)
+
+struct Exportacao {
+  WiFiClient cliente;                            // Conexão mantida após o handler retornar
+  bool ativa;                                    // Exportação em andamento
+  uint8_t formato;                               // FORMATO_*
+  uint8_t fase;                                  // FASE_*
+  uint32_t desde;                                // Primeiro epoch pedido
+  uint32_t ate;                                  // Último epoch pedido
+  uint32_t ultimoEpoch;                          // Epoch da última leitura enviada (0 se nenhuma)
+  uint32_t segmento;                             // FASE_FLASH: segmento em leitura
+  File arquivo;                                  // FASE_FLASH: arquivo do segmento aberto
+  BlocoHistorico bloco;                          // FASE_FLASH: bloco carregado
+  int indiceBloco;                               // FASE_FLASH: próxima leitura de "bloco"
+  decltype(historico)::const_iterator cursorRam; // FASE_RAM: próxima leitura em "historico"
+  unsigned long ultimoEnvio;                     // millis() do último avanço do envio
+  size_t pendentes;                              // Bytes aguardando envio em "buffer"
+  char buffer[BUFFER_EXPORTACAO];                // Dados ainda não aceitos pelo socket
+};
+
+Exportacao exportacao;
+
+// Destino do EscritorJson ao formatar a exportação: acumula em exportacao.buffer. Quem formata
+// garante o espaço (atenderExportacao encerra a fatia antes); o corte só protege a memória.
+void acumularExportacao(const char* dados, size_t tamanho) {
+  if (exportacao.pendentes + tamanho > BUFFER_EXPORTACAO) tamanho = BUFFER_EXPORTACAO - exportacao.pendentes;
+  memcpy(exportacao.buffer + exportacao.pendentes, dados, tamanho);
+  exportacao.pendentes += tamanho;
+}
+
+// Primeira leitura de um segmento (0 se ele não existir ou o primeiro bloco for inválido)
+uint32_t epochInicialSegmento(uint32_t numero) {
+  char caminho[32];
+  caminhoSegmento(numero, caminho, sizeof(caminho));
+  File arquivo = LittleFS.open(caminho, "r");
+  if (!arquivo) return 0;
+  BlocoHistorico bloco;
+  bool lido = arquivo.read((uint8_t*)&bloco, sizeof(bloco)) == sizeof(bloco);
+  arquivo.close();
+  return lido && bloco.magica == MAGICA_BLOCO ? bloco.amostras[0].epoch : 0;
+}
+
+// Primeira leitura do bloco "indice" do arquivo aberto (0 se inválido)
+uint32_t epochInicialBloco(File& arquivo, uint32_t indice) {
+  uint32_t cabecalho[2];
+  Amostra primeira;
+  arquivo.seek(indice * sizeof(BlocoHistorico));
+  if (arquivo.read((uint8_t*)cabecalho, sizeof(cabecalho)) != sizeof(cabecalho) || cabecalho[0] != MAGICA_BLOCO) return 0;
+  if (arquivo.read((uint8_t*)&primeira, sizeof(primeira)) != sizeof(primeira)) return 0;
+  return primeira.epoch;
+}
+
+// Primeira leitura em RAM com epoch >= "epoch" (busca binária por bloco; o histórico está em
+// ordem de tempo)
+decltype(historico)::const_iterator primeiraNaRam(uint32_t epoch) {
+  return historico.iterador(historico.primeiraComEpoch(epoch));
+}
+
+// Posiciona a exportação no último bloco da flash que começa em ou antes de "desde"
+void localizarNaFlash() {
+  uint32_t escolhido = primeiroSegmento;
+  long inicio = primeiroSegmento;
+  long fim = blocosNoSegmento > 0 ? segmentoAtual : (long)segmentoAtual - 1; // Último segmento com dados
+  while (inicio <= fim) { // Último segmento com primeira leitura <= desde
+    long meio = (inicio + fim) / 2;
+    uint32_t epoch = epochInicialSegmento(meio);
+    if (epoch != 0 && epoch <= exportacao.desde) {
+      escolhido = meio;
+      inicio = meio + 1;
+    } else {
+      fim = meio - 1;
+    }
+  }
+
+  exportacao.segmento = escolhido;
+  exportacao.indiceBloco = AMOSTRAS_POR_BLOCO; // Nenhum bloco carregado ainda
+  char caminho[32];
+  caminhoSegmento(escolhido, caminho, sizeof(caminho));
+  exportacao.arquivo = LittleFS.open(caminho, "r");
+  if (!exportacao.arquivo) return;
+  uint32_t blocoEscolhido = 0;
+  uint32_t blocoInicio = 0, blocoFim = exportacao.arquivo.size() / sizeof(BlocoHistorico);
+  while (blocoInicio < blocoFim) { // Último bloco com primeira leitura <= desde
+    uint32_t meio = blocoInicio + (blocoFim - blocoInicio) / 2;
+    uint32_t epoch = epochInicialBloco(exportacao.arquivo, meio);
+    if (epoch != 0 && epoch <= exportacao.desde) {
+      blocoEscolhido = meio;
+      blocoInicio = meio + 1;
+    } else {
+      blocoFim = meio;
+    }
+  }
+  exportacao.arquivo.seek(blocoEscolhido * sizeof(BlocoHistorico));
+}
+
+// Carrega o próximo bloco válido da flash, passando aos segmentos seguintes; false ao fim da flash
+bool carregarProximoBloco() {
+  for (;;) {
+    if (exportacao.arquivo) {
+      if (exportacao.arquivo.read((uint8_t*)&exportacao.bloco, sizeof(exportacao.bloco)) == sizeof(exportacao.bloco)) {
+        if (exportacao.bloco.magica != MAGICA_BLOCO ||
+            exportacao.bloco.crc != calcularCrc(exportacao.bloco.amostras, sizeof(exportacao.bloco.amostras))) continue;
+        exportacao.indiceBloco = 0;
+        return true;
+      }
+      exportacao.arquivo.close();
+    }
+    exportacao.segmento++;
+    if (exportacao.segmento < primeiroSegmento) exportacao.segmento = primeiroSegmento; // Apagado durante a exportação
+    if (exportacao.segmento > segmentoAtual) return false;
+    char caminho[32];
+    caminhoSegmento(exportacao.segmento, caminho, sizeof(caminho));
+    exportacao.arquivo = LittleFS.open(caminho, "r");
+  }
+}
+
+// Próxima leitura do intervalo pedido; false quando não há mais
+bool proximaAmostraExportada(Amostra& amostra) {
+  while (exportacao.fase == FASE_FLASH) {
+    if (exportacao.indiceBloco < AMOSTRAS_POR_BLOCO) {
+      amostra = exportacao.bloco.amostras[exportacao.indiceBloco++];
+      if (amostra.epoch < exportacao.desde) continue;
+      if (amostra.epoch > exportacao.ate) {
+        exportacao.fase = FASE_FIM;
+        return false;
+      }
+      exportacao.ultimoEpoch = amostra.epoch;
+      return true;
+    }
+    if (!carregarProximoBloco()) { // Fim da flash: o restante (lote não gravado) está na RAM
+      exportacao.fase = FASE_RAM;
+      uint32_t desde = exportacao.ultimoEpoch >= exportacao.desde ? exportacao.ultimoEpoch + 1 : exportacao.desde;
+      exportacao.cursorRam = primeiraNaRam(desde);
+    }
+  }
+  if (exportacao.fase != FASE_RAM) return false;
+  uint32_t maisAntiga = historico.total() - historico.size();
+  if (exportacao.cursorRam.sequencia() < maisAntiga) exportacao.cursorRam = historico.begin(); // Descartada durante a exportação
+  if (exportacao.cursorRam == historico.end()) {
+    exportacao.fase = FASE_FIM;
+    return false;
+  }
+  amostra = *exportacao.cursorRam;
+  ++exportacao.cursorRam;
+  if (amostra.epoch > exportacao.ate) {
+    exportacao.fase = FASE_FIM;
+    return false;
+  }
+  return true;
+}
+
+void escreverAmostraExportada(EscritorJson& json, const Amostra& amostra) {
+  if (exportacao.formato == FORMATO_BINARIO) {
+    json.escrever((const char*)&amostra, sizeof(amostra));
+    return;
+  }
+  bool ndjson = exportacao.formato == FORMATO_NDJSON;
+  json.escrever(ndjson ? "{\"epoch\":" : "");
+  json.escreverInteiro(amostra.epoch);
+  json.escrever(ndjson ? ",\"temperatura\":" : ",");
+  json.escreverCentesimos(amostra.temperatura, 2);
+  json.escrever(ndjson ? ",\"umidade\":" : ",");
+  json.escreverCentesimos(amostra.umidade, 2);
+  json.escrever(ndjson ? "}\n" : "\n");
+}
+
+void encerrarExportacao() {
+  if (exportacao.arquivo) exportacao.arquivo.close();
+  exportacao.cliente.stop();
+  exportacao.ativa = false;
+  exportacao.pendentes = 0;
+}
+
+// Envia o que o socket aceitar agora, sem esperar
+void esvaziarExportacao() {
+  if (exportacao.pendentes == 0) return;
+  int enviados = send(exportacao.cliente.fd(), exportacao.buffer, exportacao.pendentes, MSG_DONTWAIT);
+  if (enviados < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) encerrarExportacao();
+    return;
+  }
+  if (enviados > 0) exportacao.ultimoEnvio = millis();
+  exportacao.pendentes -= enviados;
+  memmove(exportacao.buffer, exportacao.buffer + enviados, exportacao.pendentes);
+}
+
+// Chamado a cada passagem do loop: envia o pendente e, com o buffer vazio, formata a próxima fatia.
+// A fatia termina antes de uma leitura que poderia não caber no buffer; essa leitura ainda não foi
+// retirada da origem e abre a fatia seguinte.
+void atenderExportacao() {
+  if (!exportacao.ativa) return;
+  esvaziarExportacao();
+  if (!exportacao.ativa) return;
+  if (exportacao.pendentes > 0) { // Socket cheio: tenta de novo na próxima passagem
+    if (millis() - exportacao.ultimoEnvio >= ESPERA_MAXIMA_EXPORTACAO) encerrarExportacao();
+    return;
+  }
+  if (exportacao.fase == FASE_FIM) { // Tudo enviado: o fim da conexão marca o fim dos dados
+    encerrarExportacao();
+    return;
+  }
+
+  EscritorJson json;
+  json.saida = acumularExportacao;
+  Amostra amostra;
+  for (int i = 0; i < AMOSTRAS_POR_PASSAGEM; i++) {
+    if (exportacao.pendentes + json.usado + MAXIMO_LINHA_EXPORTACAO > BUFFER_EXPORTACAO) break;
+    if (!proximaAmostraExportada(amostra)) break;
+    escreverAmostraExportada(json, amostra);
+  }
+  json.descarregar();
+  esvaziarExportacao();
+}
+
+void handleExport() {
+  uint8_t formato = FORMATO_CSV;
+  String nomeFormato = server.hasArg("format") ? server.arg("format") : "csv";
+  if (nomeFormato == "ndjson") formato = FORMATO_NDJSON;
+  else if (nomeFormato == "bin") formato = FORMATO_BINARIO;
+  else if (nomeFormato != "csv") {
+    server.send(400, "text/plain", "format deve ser csv, ndjson ou bin");
+    return;
+  }
+  uint32_t desde = strtoul(server.arg("from").c_str(), NULL, 10); // Ausente: desde o início
+  uint32_t ate = server.hasArg("to") ? strtoul(server.arg("to").c_str(), NULL, 10) : epochAtual();
+  if (desde > ate) {
+    server.send(400, "text/plain", "from deve ser menor ou igual a to");
+    return;
+  }
+  if (exportacao.ativa) {
+    server.send(503, "text/plain", "Exportação em andamento; tente novamente");
+    return;
+  }
+
+  exportacao.cliente = server.client(); // Cópia da conexão: continua aberta após o handler
+  exportacao.ativa = true;
+  exportacao.formato = formato;
+  exportacao.desde = desde;
+  exportacao.ate = ate;
+  exportacao.ultimoEpoch = 0;
+  exportacao.ultimoEnvio = millis();
+  if (armazenamentoAtivo) {
+    exportacao.fase = FASE_FLASH;
+    localizarNaFlash();
+  } else {
+    exportacao.fase = FASE_RAM;
+    exportacao.cursorRam = primeiraNaRam(desde);
+  }
+
+  static const char* tipos[] = {"text/csv", "application/x-ndjson", "application/octet-stream"};
+  exportacao.pendentes = 0;
+  EscritorJson json;
+  json.saida = acumularExportacao;
+  json.escrever("HTTP/1.1 200 OK\r\nContent-Type: ");
+  json.escrever(tipos[formato]);
+  json.escrever("\r\nConnection: close\r\n\r\n"); // Sem tamanho: o fim da conexão encerra os dados
+  if (formato == FORMATO_CSV) json.escrever("epoch,temperatura,umidade\n");
+  json.descarregar();
+  esvaziarExportacao();
+}
+
+/*
+ * SEÇÃO 13: LEITURA DOS SENSORES
+ * Os sensores são lidos por uma tarefa FreeRTOS dedicada no núcleo 0, de modo que o loop (e o
+ * servidor web) nunca espera uma transação no barramento. As leituras dos canais são defasadas
+ * ao longo do intervalo (canal i em i * intervaloLeitura / NUM_CANAIS) e entregues ao loop por
+ * uma fila; o loop as registra sem acesso ao hardware.
+ */
+// Espera, sem ocupar o núcleo, até o instante "prazo" de millis()
+void esperarAte(unsigned long prazo) {
+  long resta;
+  while ((resta = (long)(prazo - millis())) > 0) {
+    vTaskDelay(pdMS_TO_TICKS(resta)); // Prazo absoluto: a duração das leituras não acumula atraso
+  }
+}
+
+// Recebe o temporizador da amostragem (período intervaloLeitura, uma rodada por todos os canais).
+// Cada canal é lido na sua fração da rodada, contada a partir do prazo da rodada: com uma divisão
+// que não é exata (ex.: 3 canais), nenhum canal acumula o arredondamento.
+void tarefaSensores(void* parametro) {
+  Temporizador& amostragem = *(Temporizador*)parametro;
+  for (;;) {
+    esperarAte(amostragem.prazo);
+    marcarExecucao(amostragem, millis());
+    unsigned long inicioRodada = amostragem.prazo - amostragem.periodo; // Prazo atendido (o último, se atrasou)
+    for (int canal = 0; canal < NUM_CANAIS; canal++) {
+      esperarAte(inicioRodada + (unsigned long)canal * intervaloLeitura / NUM_CANAIS);
+      LeituraCanal leitura;
+      leitura.canal = canal;
+      if (travaFrequencia) esp_pm_lock_acquire(travaFrequencia); // Temporização do barramento a 240 MHz
+      {
+        Medicao medicao(latenciaSensor);
+        leitura.valida = canais[canal].sensor->ler(leitura.temperatura, leitura.umidade);
+      }
+      if (travaFrequencia) esp_pm_lock_release(travaFrequencia);
+      if (xQueueSend(filaLeituras, &leitura, 0) != pdTRUE) leiturasDescartadas++; // Não bloqueia
+    }
+  }
+}
+
+// Chamado pelo loop para cada leitura recebida da tarefa de sensores
+void processarLeitura(const LeituraCanal& leitura) {
+  Canal& canal = canais[leitura.canal];
+  if (!leitura.valida) {
+    canal.falhas++;
+    return;
+  }
+  if (!relogioSincronizado) { // Sem instante confiável para a leitura
+    leiturasSemRelogio++;
+    return;
+  }
+  Amostra amostra = {epochAtual(), (int16_t)paraCentesimos(leitura.temperatura), (uint16_t)paraCentesimos(leitura.umidade)};
+  canal.registrar(amostra);
+  avaliarRegras(leitura.canal, amostra); // Enfileira alertas das regras que mudaram de estado
+  if (leitura.canal != CANAL_PRINCIPAL) return;
+
+  registrarAmostra(amostra, true); // Histórico, agregação e flash (a leitura também é o log)
+  publicarAmostras(); // Envia a leitura aos navegadores conectados em /stream
+}
+
+// Escreve um canal: última leitura, falhas, estatísticas acumuladas e, se pedido, o histórico
+void escreverCanal(EscritorJson& json, int indice, bool comHistorico) {
+  const Canal& canal = canais[indice];
+  json.escrever("{ \"canal\": ");
+  json.escreverInteiro(indice);
+  json.escrever(", \"nome\": \"");
+  json.escrever(canal.nome);
+  json.escrever("\", \"leituras\": ");
+  json.escreverInteiro(canal.historico.total());
+  json.escrever(", \"falhas\": ");
+  json.escreverInteiro(canal.falhas);
+  json.escrever(", \"ultima\": ");
+  if (canal.historico.empty()) {
+    json.escrever("null");
+  } else {
+    const Amostra& ultima = canal.historico.back();
+    json.escrever("{ \"epoch\": ");
+    json.escreverInteiro(ultima.epoch);
+    json.escrever(", \"temperatura\": ");
+    json.escreverCentesimos(ultima.temperatura, 2);
+    json.escrever(", \"umidade\": ");
+    json.escreverCentesimos(ultima.umidade, 2);
+    json.escrever(" }");
+  }
+  json.escrever(", \"inicio\": ");
+  json.escreverInteiro(canal.acumulado.epoch);
+  json.escrever(", ");
+  escreverEstatistica(json, "temperatura", canal.acumulado.temperatura);
+  json.escrever(", ");
+  escreverEstatistica(json, "umidade", canal.acumulado.umidade);
+  if (comHistorico) {
+    json.escrever(", \"temperaturas\": [");
+    escreverSerie(json, canal.historico, canal.historico.size(), temperaturaDe);
+    json.escrever("], \"umidades\": [");
+    escreverSerie(json, canal.historico, canal.historico.size(), umidadeDe);
+    json.escrever("]");
+  }
+  json.escrever(" }");
+}
+
+/*
+ * GET /canais -> todos os canais, com última leitura, falhas e estatísticas desde a inicialização.
+ * GET /canais?canal=N -> apenas o canal N, incluindo suas leituras recentes (até capacidadeCanal).
+ */
+void handleCanais() {
+  int escolhido = -1;
+  if (server.hasArg("canal")) {
+    escolhido = server.arg("canal").toInt();
+    if (escolhido < 0 || escolhido >= NUM_CANAIS) {
+      server.send(404, "text/plain", "Canal inexistente");
+      return;
+    }
+  }
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN); // Tamanho desconhecido: resposta em chunks
+  server.send(200, "application/json", "");       // Envia apenas os cabeçalhos HTTP
+  EscritorJson json;
+  if (escolhido >= 0) {
+    escreverCanal(json, escolhido, true);
+  } else {
+    json.escrever("{ \"canais\": [");
+    for (int i = 0; i < NUM_CANAIS; i++) {
+      if (i > 0) json.escrever(", ");
+      escreverCanal(json, i, false);
+    }
+    json.escrever("], \"descartadas\": ");
+    json.escreverInteiro(leiturasDescartadas);
+    json.escrever(" }");
+  }
+  json.descarregar();
+  server.sendContent("", 0);
+}
+
+/*
+ * SEÇÃO 14: CONFIGURAÇÃO INICIAL
+ * Inicializa o hardware, conecta ao Wi-Fi, configura os sensores, sincroniza o tempo e inicia o servidor web.
  */
 void setup() {
   Serial.begin(115200); // Inicia comunicação serial para depuração
-  dht.begin(); // Inicializa o sensor DHT22
+  idBoot = esp_random(); // Identifica esta execução para os clientes do modo incremental
+  for (Canal& canal : canais) canal.sensor->iniciar(); // Inicializa os sensores de todos os canais
 
   WiFi.begin(ssid, password); // Inicia conexão Wi-Fi com as credenciais fornecidas
   Serial.print("Conectando ao Wi-Fi");
@@ -344,65 +2512,69 @@ void setup() {
   Serial.println(WiFi.localIP()); // Exibe o endereço IP atribuído
 
   client.setInsecure(); // Configura cliente HTTPS para aceitar certificados não confiáveis (Telegram)
+  filaAlertas = xQueueCreate(TAMANHO_FILA_ALERTAS, sizeof(Alerta)); // Fila de alertas pendentes
+  xTaskCreatePinnedToCore(tarefaAlertas, "alertas", 10240, NULL, 1, NULL, 0); // Envio no núcleo 0, fora do loop
+  filaLeituras = xQueueCreate(TAMANHO_FILA_LEITURAS, sizeof(LeituraCanal)); // Leituras a registrar
 
   timeClient.begin(); // Inicia o cliente NTP
-  timeClient.update(); // Sincroniza o tempo
-  Serial.println("Hora sincronizada: " + getFormattedTime()); // Exibe hora sincronizada
+  sincronizarRelogio(); // Sincroniza o tempo e ancora o relógio local
+  if (relogioSincronizado) {
+    char horaSincronizada[17];
+    formatarEpoch(epochAtual(), horaSincronizada, sizeof(horaSincronizada));
+    Serial.printf("Hora sincronizada: %s\n", horaSincronizada); // Exibe hora sincronizada
+  } else {
+    Serial.println("NTP sem resposta; leituras descartadas até a sincronização");
+  }
 
+  recuperarHistorico(); // Reconstrói histórico e agregados gravados na flash
+  carregarRegras(); // Regras de alerta configuradas em execuções anteriores
+  // Leitura dos sensores no núcleo 0, com prioridade acima do envio de alertas (que pode esperar a rede);
+  // só começa após a recuperação, para que as novas leituras venham depois das gravadas
+  Temporizador* amostragem = agendar("amostragem", intervaloLeitura, NULL);
+  if (amostragem) xTaskCreatePinnedToCore(tarefaSensores, "sensores", 4096, amostragem, 2, NULL, 0);
+  agendar("relogio", intervaloSincronizacao, sincronizarRelogio); // Reancora o relógio ao NTP
+  agendar("pulso", INTERVALO_PULSO, pulsarAssinantes); // Verifica as conexões de /stream
+  configurarEnergia(); // Frequência dinâmica e sono leve entre os eventos
+
+  const char* cabecalhos[] = {"If-None-Match"}; // Cabeçalhos da requisição lidos pelos handlers
+  server.collectHeaders(cabecalhos, 1); // Guarda o ETag enviado pelo navegador na revalidação
   server.on("/", handleRoot); // Associa a rota "/" à função handleRoot
   server.on("/dados", handleDados); // Associa a rota "/dados" à função handleDados
+  server.on("/resumo", handleResumo); // Associa a rota "/resumo" à função handleResumo
+  server.on("/stream", handleStream); // Associa a rota "/stream" (eventos SSE) à função handleStream
+  server.on("/canais", handleCanais); // Associa a rota "/canais" à função handleCanais
+  server.on("/agenda", handleAgenda); // Associa a rota "/agenda" à função handleAgenda
+  server.on("/regras", HTTP_GET, handleRegras); // Associa a rota "/regras" (consulta) à função handleRegras
+  server.on("/regras", HTTP_POST, handleAlterarRegras); // Alterações de regras apenas por POST
+  server.on("/metrics", handleMetrics); // Associa a rota "/metrics" (Prometheus) à função handleMetrics
+  server.on("/export", handleExport); // Associa a rota "/export" à função handleExport
   server.begin(); // Inicia o servidor web
   Serial.println("Servidor HTTP iniciado"); // Confirma inicialização
 }
 
 /*
- * SEÇÃO 11: LOOP PRINCIPAL
- * Executa continuamente para ler o sensor, enviar alertas, atualizar históricos e gerenciar o servidor web.
+ * SEÇÃO 15: LOOP PRINCIPAL
+ * Atende o servidor web, executa os temporizadores vencidos e registra as leituras dos sensores,
+ * dormindo entre esses eventos.
  */
 void loop() {
+  unsigned long inicio = micros();
   server.handleClient(); // Processa requisições HTTP recebidas
+  atenderAssinantes(); // Continua envios pendentes do canal de eventos
+  atenderExportacao(); // Formata e envia a próxima fatia da exportação em andamento
+  executarVencidos(millis()); // Sincronização do relógio e pulso do /stream, quando vencerem
+  despertares++;
+  uint32_t trabalho = micros() - inicio;
 
-  unsigned long agora = millis(); // Obtém o tempo atual em milissegundos
-  if (agora - ultimoTempoLeitura >= intervaloLeitura) { // Verifica se é hora de nova leitura
-    ultimoTempoLeitura = agora; // Atualiza timestamp da última leitura
-
-    float h = dht.readHumidity(); // Lê umidade do sensor
-    float t = dht.readTemperature(); // Lê temperatura do sensor
-
-    if (!isnan(h) && !isnan(t)) { // Verifica se as leituras são válidas
-      historicoTemperatura[indiceLeitura] = t; // Armazena temperatura
-      historicoUmidade[indiceLeitura] = h; // Armazena umidade
-      timestamps[indiceLeitura] = getFormattedTime(); // Armazena timestamp
-      indiceLeitura = (indiceLeitura + 1) % maxLeituras; // Avança índice (buffer circular)
-      if (totalLeituras < maxLeituras) totalLeituras++; // Incrementa total de leituras
-
-      String logStr = getFormattedTime() + " Temperatura " + String(t, 1) + "°C / Umidade " + String(h, 1) + "%"; // Cria entrada de log
-      logEntradas[indiceLog] = logStr; // Armazena log
-      indiceLog = (indiceLog + 1) % maxLog; // Avança índice (buffer circular)
-      if (totalLog < maxLog) totalLog++; // Incrementa total de logs
-
-      if (t > TEMP_THRESHOLD) { // Verifica se a temperatura excede o limite
-        Serial.printf("Temperatura: %.1f°C, Umidade: %.1f%%, enviando alerta...\n", t, h); // Log de alerta
-        sendTelegramAlert(t, h); // Envia alerta ao Telegram
-      }
-
-      somaTemperatura += t; // Acumula temperatura para média
-      somaUmidade += h; // Acumula umidade para média
-      leiturasPorHora++; // Incrementa contador de leituras por hora
-    }
-
-    if (agora - ultimaHora >= intervaloHora) { // Verifica se é hora de calcular média horária
-      if (leiturasPorHora > 0) { // Se houver leituras na hora
-        mediasTemperatura[indiceHora] = somaTemperatura / leiturasPorHora; // Calcula média de temperatura
-        mediasUmidade[indiceHora] = somaUmidade / leiturasPorHora; // Calcula média de umidade
-        horas[indiceHora] = getFormattedTime().substring(11, 16); // Armazena hora (HH:MM)
-        indiceHora = (indiceHora + 1) % maxHoras; // Avança índice (buffer circular)
-        if (totalHoras < maxHoras) totalHoras++; // Incrementa total de horas
-        somaTemperatura = 0; // Reseta acumulador de temperatura
-        somaUmidade = 0; // Reseta acumulador de umidade
-        leiturasPorHora = 0; // Reseta contador de leituras
-      }
-      ultimaHora = agora; // Atualiza timestamp da última média
-    }
+  // Dorme até o próximo prazo, a chegada de uma leitura ou a próxima verificação da rede
+  unsigned long espera = esperaAteProximoPrazo(millis(), exportacao.ativa ? 1 : intervaloRede);
+  LeituraCanal leitura;
+  if (xQueueReceive(filaLeituras, &leitura, pdMS_TO_TICKS(espera)) == pdTRUE) {
+    inicio = micros();
+    do {
+      processarLeitura(leitura); // Leituras entregues pela tarefa de sensores
+    } while (xQueueReceive(filaLeituras, &leitura, 0) == pdTRUE);
+    trabalho += micros() - inicio;
   }
+  latenciaLoop.registrar(trabalho);
 }
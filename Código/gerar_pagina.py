@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+"""
+Gera pagina_html_gz.h a partir de pagina.html.
+
+A página do painel é comprimida com gzip uma única vez, no momento da compilação, e
+gravada como um array em memória flash (PROGMEM). O ESP32 a envia diretamente com
+Content-Encoding: gzip, sem copiá-la para a RAM. O ETag é derivado do conteúdo
+comprimido, de modo que muda sempre que a página é alterada.
+
+Uso: python3 gerar_pagina.py   (execute após editar pagina.html)
+"""
+import gzip
+import hashlib
+import os
+
+DIRETORIO = os.path.dirname(os.path.abspath(__file__))
+ENTRADA = os.path.join(DIRETORIO, "pagina.html")
+SAIDA = os.path.join(DIRETORIO, "pagina_html_gz.h")
+BYTES_POR_LINHA = 16
+
+
+def main():
+    with open(ENTRADA, "rb") as arquivo:
+        html = arquivo.read()
+
+    # mtime=0 torna a saída determinística: mesma página, mesmos bytes e mesmo ETag
+    comprimido = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(comprimido).hexdigest()[:16]
+
+    linhas = []
+    for inicio in range(0, len(comprimido), BYTES_POR_LINHA):
+        trecho = comprimido[inicio:inicio + BYTES_POR_LINHA]
+        linhas.append("  " + ", ".join("0x%02x" % b for b in trecho) + ",")
+
+    with open(SAIDA, "w", encoding="utf-8", newline="\n") as arquivo:
+        arquivo.write("// Arquivo gerado por gerar_pagina.py a partir de pagina.html. Não edite manualmente.\n")
+        arquivo.write("// Página original: %d bytes; comprimida (gzip): %d bytes.\n" % (len(html), len(comprimido)))
+        arquivo.write("#pragma once\n\n")
+        arquivo.write("#define PAGINA_HTML_ETAG \"\\\"%s\\\"\" // ETag forte derivado do conteúdo\n" % etag)
+        arquivo.write("const size_t PAGINA_HTML_GZ_TAMANHO = %d; // Tamanho da página comprimida (bytes)\n" % len(comprimido))
+        arquivo.write("const uint8_t PAGINA_HTML_GZ[] PROGMEM = {\n")
+        arquivo.write("\n".join(linhas) + "\n")
+        arquivo.write("};\n")
+
+    print("%s: %d -> %d bytes (ETag %s)" % (os.path.basename(SAIDA), len(html), len(comprimido), etag))
+
+
+if __name__ == "__main__":
+    main()
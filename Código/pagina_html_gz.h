@@ -0,0 +1,228 @@
+// Arquivo gerado por gerar_pagina.py a partir de pagina.html. Não edite manualmente.
+// Página original: 11167 bytes; comprimida (gzip): 3506 bytes.
+#pragma once
+
+#define PAGINA_HTML_ETAG "\"09062078ea1df4d7\"" // ETag forte derivado do conteúdo
+const size_t PAGINA_HTML_GZ_TAMANHO = 3506; // Tamanho da página comprimida (bytes)
+const uint8_t PAGINA_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x1a, 0x5d, 0x6f, 0xdc, 0xc6,
+  0xf1, 0xdd, 0xbf, 0x62, 0xcd, 0x20, 0xf1, 0x5d, 0x7a, 0x1f, 0x3a, 0x39, 0x29, 0x8a, 0x93, 0x4e,
+  0x85, 0x2c, 0xcb, 0xb1, 0x03, 0x29, 0x36, 0x2c, 0xa5, 0x48, 0x60, 0x18, 0xc5, 0x1e, 0xb9, 0x77,
+  0xb7, 0x0e, 0xb9, 0x4b, 0xef, 0x2e, 0x4f, 0x92, 0x13, 0x3d, 0x16, 0xe8, 0x43, 0x81, 0x02, 0xed,
+  0x5b, 0x51, 0xa0, 0x55, 0xf3, 0x10, 0x34, 0x40, 0x81, 0x02, 0x41, 0x81, 0x22, 0x8f, 0xbd, 0x1f,
+  0xd4, 0xfe, 0x84, 0xce, 0xec, 0x92, 0x7b, 0x4b, 0xde, 0x9d, 0x65, 0x3b, 0x46, 0xd0, 0x87, 0x5a,
+  0xb6, 0x45, 0x2e, 0x67, 0xe7, 0x7b, 0x66, 0x67, 0x86, 0xdc, 0xbd, 0x79, 0xf7, 0xe1, 0xc1, 0xe9,
+  0xe7, 0x8f, 0x0e, 0xc9, 0xcc, 0x64, 0xe9, 0xde, 0x8d, 0x5d, 0xfc, 0x45, 0x52, 0x2a, 0xa6, 0xa3,
+  0x28, 0x37, 0xdd, 0x3b, 0x8f, 0x23, 0x5c, 0x63, 0x34, 0xd9, 0xbb, 0x41, 0xc8, 0x6e, 0xc6, 0x0c,
+  0x25, 0xf1, 0x8c, 0x2a, 0xcd, 0xcc, 0x28, 0xfa, 0xf4, 0xf4, 0x5e, 0xf7, 0x67, 0x11, 0xe9, 0xef,
+  0x91, 0xdd, 0x9b, 0xdd, 0x2e, 0xb9, 0xcb, 0x26, 0x5c, 0x30, 0x12, 0xcb, 0x84, 0x4f, 0x78, 0x4c,
+  0x17, 0xdf, 0x2c, 0xbe, 0x96, 0x24, 0x81, 0x05, 0xaa, 0x68, 0x6c, 0x98, 0x62, 0x9a, 0x74, 0xbb,
+  0x4b, 0x34, 0x82, 0x66, 0x6c, 0x14, 0xcd, 0x39, 0x3b, 0xcb, 0xa5, 0x32, 0x11, 0xec, 0x13, 0x86,
+  0x09, 0x40, 0x7b, 0xc6, 0x13, 0x33, 0x1b, 0x25, 0x6c, 0xce, 0x63, 0xd6, 0xb5, 0x37, 0x1d, 0xc2,
+  0x05, 0x37, 0x9c, 0xa6, 0x5d, 0x1d, 0xd3, 0x94, 0x8d, 0x06, 0xbd, 0xad, 0x25, 0xd9, 0x03, 0x29,
+  0x26, 0x7c, 0x5a, 0x28, 0x4a, 0x80, 0x42, 0x2e, 0x85, 0xe6, 0x73, 0x9e, 0x50, 0xa0, 0x5b, 0x12,
+  0x33, 0xdc, 0xa4, 0x6c, 0xef, 0x58, 0x02, 0x06, 0xa9, 0x80, 0xa6, 0x30, 0x92, 0x1c, 0x9e, 0x3c,
+  0xba, 0xbd, 0xbd, 0xdb, 0x77, 0x8f, 0x1c, 0x9a, 0xd3, 0xc5, 0xdf, 0x4c, 0x91, 0x02, 0xc3, 0x94,
+  0xe4, 0x8b, 0xab, 0x29, 0x17, 0xb4, 0x42, 0xa0, 0xcd, 0x05, 0x40, 0xc1, 0x15, 0x21, 0x63, 0x99,
+  0x5c, 0x90, 0x2f, 0xed, 0x25, 0x21, 0x13, 0x60, 0xb8, 0x3b, 0xa1, 0x19, 0x4f, 0x2f, 0x86, 0x64,
+  0x5f, 0x01, 0x7b, 0x1d, 0xa2, 0xa9, 0xd0, 0x5d, 0xcd, 0x14, 0x9f, 0xec, 0x90, 0xfe, 0xfb, 0xe4,
+  0x1e, 0xca, 0x44, 0x72, 0x9a, 0x28, 0xd4, 0xc5, 0xfb, 0xfd, 0x72, 0xe7, 0x98, 0xc6, 0x5f, 0x4c,
+  0x95, 0x2c, 0x44, 0x32, 0x24, 0x67, 0x33, 0x6e, 0x98, 0x03, 0x86, 0x7b, 0x49, 0xc6, 0x8a, 0x8a,
+  0x38, 0x80, 0x8d, 0x65, 0x2a, 0xd5, 0x90, 0xbc, 0x73, 0xfb, 0xf6, 0x6d, 0x0b, 0x75, 0x20, 0x15,
+  0x01, 0x30, 0xc3, 0xce, 0x4d, 0x00, 0x05, 0x24, 0x12, 0x2e, 0xa6, 0x43, 0x72, 0x7b, 0x2b, 0x3f,
+  0xb7, 0x70, 0x87, 0x3a, 0x07, 0x13, 0x94, 0xf2, 0x72, 0x60, 0x43, 0x89, 0x00, 0x1e, 0xb7, 0x77,
+  0x69, 0xca, 0xa7, 0x62, 0x48, 0x62, 0x86, 0x4f, 0x1d, 0x72, 0xb8, 0x54, 0xb0, 0xfc, 0x82, 0xd6,
+  0x09, 0x5c, 0xda, 0xff, 0x7b, 0x68, 0x22, 0x0a, 0x36, 0x56, 0x5e, 0x07, 0xa1, 0x24, 0xef, 0x4c,
+  0x3e, 0xc4, 0x9f, 0x40, 0x16, 0xf8, 0x8b, 0x5b, 0x16, 0xdf, 0xda, 0x3d, 0x4b, 0xf1, 0xa5, 0x4a,
+  0x98, 0xea, 0x2a, 0x9a, 0xf0, 0x42, 0x0f, 0xc9, 0xa0, 0x62, 0xf9, 0x0e, 0xac, 0x53, 0x4d, 0xa8,
+  0x52, 0x2c, 0x91, 0x02, 0x6c, 0x08, 0x37, 0x6f, 0x2c, 0x61, 0x46, 0x15, 0x18, 0xb1, 0x3b, 0x96,
+  0xc6, 0xc8, 0x2c, 0xd8, 0x75, 0x0c, 0xeb, 0x2c, 0x03, 0xf8, 0x09, 0x58, 0x49, 0x06, 0x5c, 0x25,
+  0x5c, 0xe7, 0x29, 0x05, 0x53, 0x72, 0x91, 0x02, 0xbf, 0xdd, 0x71, 0x2a, 0xe3, 0x2f, 0x4a, 0x95,
+  0x7b, 0x19, 0xe8, 0xb3, 0x42, 0x1b, 0x0a, 0x72, 0x51, 0x27, 0x1a, 0x5b, 0x7c, 0x9f, 0x84, 0x86,
+  0x95, 0xe7, 0x5d, 0x3d, 0x83, 0xe7, 0x67, 0x43, 0xb2, 0x45, 0xb6, 0xf3, 0x73, 0xf2, 0x01, 0xfc,
+  0x53, 0xd3, 0x31, 0x6d, 0x6d, 0x75, 0xec, 0x4f, 0x6f, 0xd0, 0xb6, 0x38, 0x4f, 0x64, 0x06, 0x96,
+  0x26, 0x29, 0x9b, 0xb3, 0xba, 0x92, 0x67, 0x03, 0xf2, 0xa5, 0x73, 0x2d, 0xcd, 0x5f, 0xb0, 0x21,
+  0xd9, 0x66, 0xd9, 0x4e, 0xdd, 0x09, 0x2e, 0x9d, 0xf0, 0x86, 0xa7, 0x56, 0xc3, 0xa6, 0x74, 0xdc,
+  0x5c, 0x71, 0x11, 0xf3, 0x9c, 0xa6, 0x15, 0xbe, 0xd9, 0x36, 0x60, 0xaa, 0xed, 0x2c, 0x75, 0x62,
+  0x64, 0x3e, 0x24, 0x1f, 0x58, 0x85, 0xd4, 0x71, 0x69, 0xa2, 0x8b, 0x71, 0x89, 0xcf, 0xab, 0x3e,
+  0xaf, 0xf3, 0x33, 0xe8, 0xdd, 0xbe, 0x86, 0x23, 0x0d, 0xb6, 0x52, 0x10, 0x42, 0x8a, 0x4e, 0x96,
+  0x58, 0x7a, 0x98, 0x35, 0x4c, 0xf7, 0x0d, 0x3c, 0x68, 0x0a, 0xb8, 0x20, 0x9f, 0xc8, 0xb7, 0xe5,
+  0x3f, 0xdb, 0xaf, 0xe3, 0x3f, 0x0e, 0x9c, 0xd0, 0xc2, 0xc8, 0x66, 0x80, 0xc4, 0x32, 0xb3, 0x40,
+  0xe0, 0x4c, 0x6f, 0xc7, 0xfe, 0x84, 0xd8, 0x64, 0x37, 0x24, 0x3f, 0xdd, 0xaa, 0x58, 0x3c, 0x02,
+  0xfc, 0x98, 0xd9, 0x26, 0xfc, 0x9c, 0xfe, 0xd0, 0xe0, 0x9d, 0xc9, 0x42, 0xa5, 0x17, 0x5d, 0xb7,
+  0xc1, 0xab, 0xff, 0x5a, 0x31, 0x67, 0x52, 0xf1, 0x17, 0x68, 0xb5, 0x14, 0x15, 0xc5, 0xd6, 0xc4,
+  0xcb, 0x32, 0x50, 0x0e, 0xcf, 0xf9, 0x18, 0x0f, 0x80, 0x4c, 0xda, 0xc5, 0x37, 0xcf, 0x37, 0xaf,
+  0xa8, 0x8a, 0x52, 0xb2, 0x54, 0x4e, 0xdf, 0xc4, 0xb1, 0x60, 0xdb, 0x8f, 0xee, 0x53, 0xe7, 0xdd,
+  0x8d, 0x82, 0x65, 0x8b, 0xab, 0x73, 0x9e, 0xd1, 0x1f, 0xe8, 0x81, 0x48, 0x62, 0xc6, 0xf8, 0x74,
+  0x66, 0x70, 0x63, 0x45, 0x63, 0x3f, 0x35, 0x6b, 0x49, 0xc8, 0x39, 0x53, 0x93, 0x54, 0x9e, 0x75,
+  0xc1, 0x8c, 0x9e, 0xc2, 0x1d, 0x10, 0x96, 0xe2, 0xc1, 0xad, 0x64, 0x4a, 0x11, 0x39, 0x00, 0x19,
+  0x38, 0xd0, 0xd3, 0xf5, 0xe6, 0x4c, 0xd9, 0xc4, 0x94, 0x44, 0xb8, 0x98, 0x95, 0xa2, 0x2f, 0xfe,
+  0x4c, 0x98, 0x7e, 0x5e, 0x30, 0x50, 0xde, 0x5b, 0xcd, 0x8e, 0xd6, 0xd6, 0xa8, 0x81, 0x8b, 0x66,
+  0x56, 0x1a, 0x60, 0x56, 0xaa, 0x54, 0xf6, 0x21, 0xe0, 0xdd, 0x7a, 0x59, 0x92, 0x02, 0x2b, 0x5a,
+  0x3d, 0xe2, 0x05, 0x48, 0xea, 0x5d, 0x61, 0xb7, 0x5f, 0x9e, 0xf6, 0xbb, 0x7d, 0x57, 0xf4, 0xec,
+  0xe2, 0x91, 0x6f, 0xcb, 0x80, 0x84, 0xcf, 0x49, 0x9c, 0x52, 0xad, 0x47, 0x91, 0x77, 0xb6, 0xc8,
+  0x95, 0x05, 0xbb, 0xb3, 0x41, 0xa3, 0xc0, 0x00, 0x9c, 0xfb, 0xd9, 0x98, 0xa3, 0xa7, 0x03, 0xa6,
+  0xc1, 0x75, 0x35, 0x06, 0xa0, 0xc8, 0x09, 0x4f, 0x46, 0x91, 0x61, 0x59, 0x1e, 0xed, 0xfd, 0xe7,
+  0x4f, 0xbf, 0xb9, 0xfa, 0xf7, 0x3f, 0x7f, 0x4b, 0x4e, 0xe1, 0x8e, 0x29, 0x6a, 0x6d, 0xb7, 0x6f,
+  0x0a, 0x9a, 0x0e, 0xb1, 0x1a, 0x51, 0x52, 0x4c, 0xf7, 0xba, 0xdd, 0x7f, 0xfd, 0xfd, 0x00, 0xb9,
+  0xb5, 0x77, 0xbb, 0xfd, 0xbc, 0x24, 0xe1, 0x42, 0xd0, 0x04, 0x1b, 0x29, 0x6e, 0x6c, 0xd2, 0x29,
+  0x32, 0x9e, 0x20, 0x9d, 0xdf, 0x7d, 0x43, 0x3e, 0xcd, 0x5c, 0xb9, 0xb4, 0x42, 0xe0, 0xdd, 0x8d,
+  0xe8, 0x8b, 0x72, 0x4b, 0x88, 0x7a, 0xb7, 0x0f, 0x0a, 0xda, 0xbb, 0x81, 0x57, 0xb3, 0x6d, 0xc0,
+  0xfc, 0xfb, 0x5f, 0x93, 0xfb, 0x5c, 0x9b, 0xc5, 0x77, 0x0a, 0x73, 0x37, 0x00, 0x1f, 0x31, 0x8e,
+  0xfc, 0x68, 0xd2, 0x5a, 0xfc, 0x21, 0x35, 0x3c, 0x83, 0xb3, 0x61, 0xb0, 0xb5, 0x45, 0x34, 0x9b,
+  0x62, 0x40, 0xea, 0x36, 0xe8, 0x69, 0xbb, 0xa9, 0xa7, 0x20, 0xfb, 0xa3, 0x95, 0x2a, 0x0c, 0x25,
+  0xc5, 0xd0, 0x22, 0xf5, 0xd3, 0xa5, 0xb2, 0x4b, 0x4c, 0xc5, 0x1c, 0xe0, 0x51, 0x62, 0x3c, 0xd3,
+  0x0f, 0x10, 0x2a, 0x72, 0xb9, 0x65, 0x14, 0x41, 0x08, 0x46, 0xc4, 0xc5, 0xca, 0x28, 0xfa, 0x00,
+  0x6e, 0x40, 0x4e, 0xb7, 0xa1, 0xaa, 0x2c, 0xdd, 0x6e, 0x38, 0xcd, 0x68, 0x9d, 0x0f, 0xf4, 0x73,
+  0xbd, 0x49, 0xee, 0x5f, 0x85, 0x72, 0x43, 0x69, 0x4b, 0xee, 0x83, 0x57, 0x54, 0x42, 0x53, 0x14,
+  0x1a, 0x73, 0x2a, 0x7d, 0x15, 0x81, 0xb3, 0xc5, 0x5f, 0x13, 0x0e, 0x5b, 0x00, 0x7e, 0x71, 0xa5,
+  0xf8, 0xab, 0x48, 0x4e, 0x6a, 0x69, 0x7e, 0x8d, 0x1e, 0xdc, 0xf3, 0xb7, 0xa1, 0x89, 0x92, 0x2b,
+  0xb9, 0x49, 0x11, 0x7f, 0x24, 0x47, 0x10, 0x56, 0x81, 0xe5, 0xd7, 0x0b, 0x8c, 0xb1, 0xb7, 0x2a,
+  0x56, 0x2d, 0xa7, 0x47, 0xce, 0x82, 0x72, 0x5a, 0xc9, 0x83, 0x28, 0x10, 0x39, 0x54, 0xda, 0x8b,
+  0x2b, 0xa8, 0x7c, 0x18, 0x13, 0xf1, 0x8c, 0x03, 0xb2, 0x39, 0xa7, 0xe4, 0x63, 0x3a, 0xa7, 0x27,
+  0xb1, 0xe2, 0xb9, 0x59, 0xe5, 0x4c, 0xbb, 0x75, 0xad, 0x62, 0xd0, 0x84, 0x31, 0xb9, 0x1e, 0xf6,
+  0xfb, 0x71, 0x22, 0x7a, 0xcf, 0x74, 0xc2, 0x52, 0x3e, 0x57, 0x3d, 0xc1, 0x4c, 0x5f, 0xe4, 0x59,
+  0xdf, 0xaa, 0x15, 0x96, 0x51, 0x15, 0x6e, 0x53, 0xc9, 0xf9, 0x03, 0x11, 0xa7, 0x05, 0x27, 0x63,
+  0x3e, 0x4e, 0xb9, 0x34, 0x2c, 0xa6, 0xe4, 0xa0, 0x04, 0xf5, 0xfd, 0x82, 0x03, 0xb7, 0x9c, 0xa6,
+  0xcc, 0x10, 0xef, 0x79, 0x1d, 0x12, 0x28, 0x1f, 0xf2, 0x5c, 0x9f, 0xfc, 0x82, 0x2a, 0xbe, 0xb8,
+  0x9a, 0x33, 0x5e, 0xea, 0x96, 0xaa, 0x8c, 0xbe, 0x60, 0x82, 0x2a, 0x38, 0x3b, 0xc0, 0x87, 0xfe,
+  0x02, 0x05, 0x1d, 0x26, 0x28, 0x08, 0x95, 0x4a, 0xeb, 0xfa, 0x86, 0x6b, 0x0a, 0xe0, 0x31, 0x39,
+  0xde, 0xff, 0xec, 0x97, 0x47, 0x87, 0x0f, 0x4e, 0x3f, 0x7d, 0xbc, 0x7f, 0x42, 0x46, 0xe0, 0x58,
+  0x16, 0xe7, 0x23, 0xd0, 0x1a, 0x6c, 0x60, 0x10, 0xa9, 0x1c, 0x77, 0x8a, 0xf5, 0x41, 0xd4, 0xc0,
+  0x73, 0xff, 0xe1, 0xeb, 0x20, 0x59, 0x71, 0xcc, 0x26, 0x57, 0x0f, 0x3f, 0x5a, 0xe2, 0x3a, 0xac,
+  0x12, 0xad, 0xc3, 0x46, 0x2d, 0x36, 0x30, 0xa6, 0x57, 0xd0, 0x58, 0x4a, 0x03, 0xe0, 0xa2, 0x48,
+  0x53, 0xbb, 0xe1, 0x41, 0x02, 0xce, 0x6b, 0x7b, 0xc8, 0x04, 0x9b, 0x1d, 0x0a, 0x1b, 0x59, 0x5c,
+  0x94, 0xfd, 0x64, 0xd9, 0xbc, 0x11, 0x38, 0x5c, 0xc8, 0x94, 0xc1, 0xf9, 0x4e, 0x80, 0x3d, 0xc8,
+  0x46, 0x01, 0xb7, 0x1e, 0x71, 0x61, 0x43, 0xee, 0x84, 0x3d, 0x07, 0xec, 0x8e, 0x17, 0xb8, 0x2e,
+  0x16, 0xdf, 0xa2, 0x5a, 0x11, 0xef, 0xe2, 0x7b, 0x0b, 0x50, 0xe9, 0x04, 0x1a, 0xc8, 0x98, 0x21,
+  0x87, 0xab, 0x08, 0x30, 0x86, 0xf5, 0x35, 0x58, 0x9c, 0x52, 0xbc, 0x4e, 0x96, 0xd8, 0x2c, 0x3a,
+  0xd8, 0x76, 0x80, 0xab, 0xa1, 0x2d, 0x21, 0x91, 0xe2, 0x76, 0x01, 0x92, 0xc2, 0x21, 0xfb, 0x62,
+  0x87, 0x60, 0xa5, 0x81, 0x39, 0x15, 0x4e, 0x77, 0x10, 0xf7, 0x1f, 0xd0, 0x31, 0xd3, 0x1c, 0xdc,
+  0x01, 0x7e, 0xc5, 0xd0, 0xdc, 0x62, 0x4c, 0xd3, 0x0c, 0x72, 0x0a, 0xda, 0xc6, 0x22, 0x9d, 0x14,
+  0x22, 0x36, 0x5c, 0x0a, 0x02, 0x2e, 0x47, 0xd5, 0x47, 0x50, 0x71, 0x23, 0xda, 0x56, 0xdb, 0x17,
+  0x41, 0x15, 0xd5, 0x35, 0xe9, 0xcb, 0x3a, 0xdc, 0xac, 0x96, 0xa2, 0x6b, 0xbe, 0x41, 0x96, 0x8e,
+  0x8b, 0xc6, 0x61, 0x67, 0xce, 0xd1, 0x5b, 0x89, 0x8c, 0x0b, 0x3c, 0xe4, 0x7a, 0x53, 0x66, 0x0e,
+  0x53, 0x86, 0x97, 0x77, 0x2e, 0x1e, 0x24, 0xad, 0x20, 0xc3, 0xb6, 0x3b, 0x9e, 0x01, 0xa8, 0x15,
+  0x2e, 0x72, 0x38, 0xa0, 0xed, 0xd3, 0xa8, 0x83, 0x0c, 0x9d, 0xf2, 0xdc, 0x52, 0xab, 0x78, 0xf2,
+  0x90, 0x09, 0x35, 0x74, 0x18, 0xec, 0x04, 0x0e, 0xe8, 0x98, 0xa5, 0x50, 0x8e, 0x3d, 0x79, 0x6a,
+  0x77, 0x3e, 0x5e, 0x7c, 0xe7, 0x5a, 0x13, 0xf0, 0x02, 0xc6, 0xcf, 0x25, 0xf9, 0x2c, 0x80, 0xc5,
+  0xdd, 0x9a, 0x19, 0x84, 0x0e, 0x56, 0x09, 0xd4, 0x09, 0x16, 0x0b, 0xb0, 0x10, 0x1e, 0xa7, 0x2d,
+  0x38, 0x3e, 0xdb, 0xc0, 0x8f, 0xa3, 0x89, 0xf8, 0x2f, 0xf6, 0xcf, 0xb9, 0x7e, 0x70, 0x77, 0x48,
+  0x6e, 0x5d, 0x0c, 0x6e, 0x75, 0xca, 0x82, 0xf0, 0xc0, 0x55, 0x10, 0xd1, 0x38, 0x2d, 0x90, 0xfb,
+  0x09, 0x4f, 0x01, 0xd1, 0x84, 0xa6, 0x9a, 0x91, 0x4b, 0xcb, 0xd2, 0x5d, 0xeb, 0x79, 0x49, 0xed,
+  0xc8, 0xdd, 0x40, 0xbe, 0x3a, 0x68, 0x5b, 0xef, 0x6e, 0x24, 0xbc, 0xbd, 0x42, 0x18, 0xca, 0xce,
+  0x26, 0xdd, 0x1a, 0xd9, 0xf2, 0x28, 0x0e, 0x48, 0x3e, 0xf5, 0xd7, 0x97, 0x1d, 0x7f, 0x29, 0x73,
+  0x74, 0x13, 0x5d, 0xd7, 0xae, 0x9f, 0x97, 0xb0, 0x12, 0xb7, 0x93, 0x88, 0x69, 0x6a, 0xf8, 0x7c,
+  0x65, 0x9c, 0x62, 0xfd, 0x05, 0xfc, 0x8f, 0x8a, 0x99, 0xc4, 0x2a, 0x5c, 0x06, 0x98, 0xec, 0x58,
+  0xa6, 0x81, 0x9d, 0x90, 0x8b, 0x01, 0xac, 0x94, 0xf6, 0xbf, 0x85, 0xf6, 0xa7, 0x0a, 0xe4, 0xcb,
+  0xa5, 0xe6, 0xc8, 0x0c, 0xae, 0x41, 0xe9, 0x08, 0x2b, 0x76, 0x0c, 0x83, 0xa0, 0xbe, 0xa5, 0x30,
+  0xaa, 0x00, 0x66, 0xb0, 0xca, 0x04, 0xa8, 0x15, 0xb3, 0xdd, 0x02, 0x1d, 0x38, 0xed, 0x1f, 0xa2,
+  0x13, 0x7c, 0x5e, 0xb2, 0xb6, 0xc1, 0x00, 0x17, 0xdb, 0xd7, 0x70, 0xa1, 0xf0, 0xdc, 0xbb, 0x9e,
+  0x8d, 0xc0, 0x7c, 0xb7, 0x90, 0xfc, 0x54, 0xf1, 0xc4, 0x42, 0x2b, 0x7a, 0xf6, 0x50, 0x58, 0xc7,
+  0xdf, 0x57, 0x8c, 0x2e, 0xcd, 0x74, 0xd9, 0xe4, 0x70, 0xd5, 0x56, 0x97, 0x37, 0x9a, 0x57, 0x97,
+  0xed, 0x9d, 0x1b, 0xaf, 0x18, 0xbb, 0xeb, 0x93, 0x30, 0x09, 0x0f, 0x99, 0x57, 0x0b, 0xdc, 0xb0,
+  0x24, 0xf8, 0xf1, 0x42, 0x97, 0xb4, 0x5c, 0x19, 0xf4, 0xc6, 0x21, 0x7c, 0xec, 0xf2, 0xed, 0xdb,
+  0x8a, 0xe4, 0xe3, 0x52, 0x9d, 0xaf, 0x15, 0xcb, 0x15, 0x0f, 0x6f, 0x21, 0xa4, 0x03, 0xfa, 0xff,
+  0xcb, 0x41, 0x7d, 0x6e, 0xa3, 0xe9, 0xe5, 0xa1, 0x82, 0xa7, 0xe5, 0x32, 0x48, 0x83, 0x5a, 0x6f,
+  0x25, 0x69, 0xff, 0x3f, 0x49, 0xbc, 0x69, 0x92, 0x70, 0xf7, 0x55, 0x69, 0xb1, 0xef, 0xeb, 0x83,
+  0xb2, 0x3c, 0xc0, 0x01, 0x65, 0x15, 0xa5, 0xe0, 0x99, 0xf0, 0x10, 0x48, 0x53, 0x9c, 0x7c, 0xc0,
+  0xb3, 0x8c, 0x42, 0xc1, 0x49, 0xa1, 0xc6, 0x9a, 0x22, 0x60, 0x8c, 0xc5, 0x0b, 0x16, 0xe2, 0x3c,
+  0xe3, 0x86, 0xd5, 0xeb, 0x0a, 0x2a, 0xd8, 0x39, 0x55, 0xae, 0x1a, 0x6c, 0x4d, 0x5d, 0x7d, 0xd1,
+  0x21, 0x4a, 0xda, 0x58, 0xee, 0x60, 0xfd, 0xcd, 0xd9, 0xa0, 0xfc, 0xbd, 0xdd, 0xc1, 0xe9, 0x03,
+  0x34, 0x76, 0xcb, 0xf2, 0xc3, 0x55, 0x84, 0xae, 0x3a, 0x1b, 0x91, 0x72, 0x7f, 0x0f, 0xe3, 0x64,
+  0xa7, 0x9a, 0x22, 0xe1, 0xb3, 0x9e, 0x4b, 0x16, 0xbd, 0xbc, 0xd0, 0xb3, 0x56, 0xaf, 0xd7, 0x2b,
+  0xf1, 0xb7, 0xeb, 0x40, 0x55, 0x76, 0x78, 0xb2, 0xf5, 0xd4, 0x5e, 0x7b, 0x70, 0xc7, 0xc5, 0x26,
+  0xe8, 0xc1, 0x3a, 0xe8, 0x6d, 0x0f, 0xed, 0x58, 0x64, 0xe7, 0x31, 0xd3, 0x5a, 0x02, 0x93, 0x35,
+  0x86, 0x52, 0x26, 0xa6, 0x66, 0x46, 0xba, 0xa5, 0x60, 0xd5, 0x1e, 0x3e, 0x21, 0xad, 0x6a, 0xc7,
+  0x1e, 0xd9, 0x6a, 0x07, 0x21, 0x52, 0xdb, 0x0e, 0x1e, 0xc2, 0x63, 0xd6, 0xda, 0xea, 0x54, 0xf8,
+  0x3d, 0xd5, 0x8d, 0x32, 0xbd, 0xc6, 0x96, 0xc1, 0xb5, 0x5b, 0x2e, 0x1b, 0x5e, 0xf2, 0x98, 0x65,
+  0x72, 0x0e, 0xe9, 0x4d, 0xa2, 0x3d, 0x56, 0xca, 0x66, 0xd2, 0xaa, 0x6a, 0x6b, 0xc5, 0x38, 0xd4,
+  0xa4, 0x1c, 0x6a, 0x6b, 0x46, 0x64, 0x58, 0x23, 0x42, 0x49, 0x2b, 0x33, 0xb6, 0xf8, 0x46, 0x16,
+  0xed, 0xba, 0x9f, 0x80, 0xef, 0x80, 0xf7, 0xda, 0xaa, 0x24, 0xa8, 0x3e, 0x9f, 0xac, 0x6f, 0x7d,
+  0x9e, 0xf6, 0x26, 0x52, 0x1d, 0xd2, 0x78, 0x56, 0x79, 0x14, 0x19, 0xed, 0x05, 0x2a, 0x0c, 0xdd,
+  0xa4, 0xd4, 0x24, 0xd8, 0xe5, 0xc9, 0xd3, 0x9d, 0xf5, 0x10, 0x95, 0x3e, 0x3c, 0x52, 0x6b, 0x60,
+  0x44, 0x69, 0x2f, 0xec, 0x73, 0xbb, 0x7f, 0xa9, 0x96, 0xa5, 0xab, 0x6c, 0xac, 0x65, 0xa1, 0xd7,
+  0x6c, 0xf7, 0xb8, 0x80, 0xe6, 0xf3, 0xfe, 0xe9, 0xf1, 0x11, 0xec, 0x8f, 0xa2, 0x6a, 0x53, 0xbd,
+  0xab, 0x68, 0x2e, 0x2e, 0x3b, 0x85, 0x66, 0x88, 0xa2, 0x99, 0xa8, 0x2d, 0xf9, 0x6d, 0x12, 0xd6,
+  0xc6, 0x0e, 0xd9, 0xfa, 0xd6, 0x08, 0x3f, 0xd7, 0x5c, 0xc4, 0x6c, 0x04, 0xee, 0x49, 0x40, 0xeb,
+  0x45, 0x46, 0xd8, 0xbc, 0x9a, 0x23, 0xe1, 0x10, 0x86, 0xd1, 0xac, 0x43, 0xf8, 0x54, 0x00, 0x6e,
+  0x1b, 0xc2, 0xb6, 0xfb, 0x79, 0x06, 0xad, 0x2f, 0x03, 0xd3, 0x5c, 0x11, 0x41, 0x2b, 0x22, 0xe5,
+  0x58, 0xa9, 0x07, 0xa6, 0x36, 0x52, 0x09, 0x5a, 0xe6, 0x19, 0xf8, 0xeb, 0xcd, 0x3d, 0x5f, 0x7c,
+  0x9b, 0x21, 0x5e, 0x59, 0x40, 0x5b, 0xb6, 0xb6, 0xb5, 0x6a, 0x95, 0xf6, 0xaf, 0xfa, 0x90, 0xaf,
+  0x65, 0xbb, 0xd7, 0x48, 0x0b, 0x56, 0x96, 0xd2, 0xde, 0xcf, 0xb4, 0x14, 0x4b, 0x9b, 0x63, 0x6c,
+  0xd8, 0x86, 0xee, 0xe6, 0xc8, 0xb5, 0x74, 0xe4, 0xbd, 0xf7, 0x08, 0x82, 0xf4, 0xfc, 0x2a, 0x5e,
+  0xb4, 0x41, 0x09, 0x90, 0x85, 0x85, 0x63, 0x70, 0xc7, 0x4f, 0x08, 0x6d, 0x27, 0xe8, 0xc1, 0xeb,
+  0x41, 0x2a, 0xe4, 0x9c, 0x6a, 0x3f, 0x46, 0x1a, 0x91, 0x63, 0x6a, 0x66, 0x3d, 0x88, 0x4c, 0x74,
+  0x7d, 0x77, 0xcd, 0x85, 0xe5, 0x06, 0x62, 0xfc, 0x39, 0x04, 0xad, 0xb7, 0x49, 0xc7, 0x61, 0x0c,
+  0x92, 0x7f, 0x15, 0xda, 0xed, 0xf6, 0x1a, 0x12, 0x95, 0x09, 0x5f, 0x8a, 0xdf, 0x01, 0x75, 0x1b,
+  0x86, 0x2f, 0x29, 0xd9, 0xca, 0x66, 0x33, 0x09, 0xa9, 0x8f, 0xe4, 0x74, 0x49, 0x01, 0xb0, 0xd6,
+  0x44, 0x2b, 0x91, 0x80, 0x0f, 0x7a, 0x1c, 0xeb, 0x7c, 0xcf, 0xb3, 0xd7, 0x94, 0x13, 0xb8, 0x6b,
+  0x6f, 0xf4, 0xcb, 0xd5, 0x5d, 0x21, 0xe3, 0x95, 0x60, 0xcb, 0x2a, 0xd4, 0x31, 0x1d, 0xaa, 0xae,
+  0x32, 0x50, 0x4d, 0x9d, 0xda, 0xe6, 0xa0, 0x4d, 0x6a, 0x06, 0x3d, 0xd5, 0x24, 0x6c, 0xdb, 0x36,
+  0xfa, 0x13, 0x5c, 0xaa, 0xa1, 0xae, 0xd1, 0x2c, 0x4f, 0x42, 0x4f, 0xaf, 0xba, 0x0f, 0x69, 0xf9,
+  0xb5, 0xeb, 0xe9, 0x54, 0xa0, 0x81, 0x9f, 0xae, 0xe3, 0xb4, 0x91, 0xcf, 0x31, 0x70, 0xcb, 0x8e,
+  0xbc, 0x36, 0x55, 0xad, 0x0f, 0x41, 0xe1, 0x38, 0x15, 0x7e, 0xa6, 0xbb, 0xcc, 0xd7, 0x9b, 0xb2,
+  0x8b, 0x9d, 0xf2, 0x36, 0xd2, 0xcb, 0x2b, 0xcc, 0x7c, 0x23, 0xf2, 0x93, 0x9a, 0xb6, 0x9e, 0xac,
+  0xd7, 0x34, 0x9c, 0x0b, 0x46, 0xde, 0xe3, 0xe7, 0x2c, 0x69, 0x0d, 0xda, 0xb0, 0x25, 0x0a, 0x27,
+  0xc5, 0xd1, 0xce, 0xf5, 0xec, 0xd9, 0xe1, 0xf0, 0x0a, 0x7b, 0x9b, 0x47, 0xc5, 0xc8, 0x57, 0xa5,
+  0xdd, 0x27, 0xab, 0x16, 0x59, 0xe1, 0xe7, 0xdd, 0x90, 0x1b, 0xcf, 0x4e, 0xad, 0xd4, 0x08, 0x0e,
+  0x8e, 0x9a, 0x90, 0x19, 0xcd, 0x5b, 0x70, 0xc0, 0x40, 0x72, 0x8f, 0xb0, 0x55, 0x09, 0x9f, 0x75,
+  0x3c, 0x0f, 0x9d, 0xda, 0x64, 0x2c, 0x38, 0x40, 0x1b, 0x7d, 0xc8, 0xda, 0xd9, 0xb2, 0xc6, 0x54,
+  0x28, 0x16, 0xdf, 0x67, 0x4c, 0xe1, 0xfb, 0x50, 0x06, 0x99, 0x16, 0x07, 0x3d, 0x5c, 0x7b, 0x2c,
+  0x9e, 0xb7, 0xc6, 0x09, 0xb5, 0x76, 0xdd, 0x71, 0xfc, 0x4b, 0xc8, 0xde, 0x96, 0xeb, 0x16, 0x07,
+  0x05, 0x0c, 0xda, 0xa0, 0x90, 0x13, 0xa3, 0xb8, 0x98, 0xb6, 0xda, 0x01, 0x7b, 0x4b, 0x04, 0x45,
+  0x0e, 0x28, 0x58, 0x2b, 0x38, 0xc8, 0x03, 0xaf, 0x0d, 0x72, 0x54, 0xc3, 0x59, 0x5d, 0xdc, 0xb8,
+  0xb3, 0xbb, 0x8a, 0x9a, 0x30, 0x15, 0x55, 0xe1, 0x61, 0x37, 0xef, 0xac, 0xd7, 0x7c, 0x70, 0x4e,
+  0xd7, 0x92, 0x99, 0x0b, 0x3a, 0x87, 0xbb, 0x5d, 0x3e, 0xc9, 0x18, 0x76, 0x2c, 0xe8, 0xb1, 0xf7,
+  0xaf, 0x81, 0x41, 0xcf, 0x59, 0x0b, 0xe3, 0x67, 0x8f, 0x81, 0x1e, 0x02, 0x16, 0x36, 0x6b, 0xa2,
+  0x5e, 0xf4, 0xda, 0xa1, 0xe2, 0x3c, 0x7c, 0xab, 0x43, 0x6b, 0xdf, 0x1e, 0xb8, 0x77, 0x3c, 0xf5,
+  0xfc, 0x02, 0x0b, 0x07, 0x7e, 0x6c, 0x3e, 0xba, 0xa6, 0x16, 0xa8, 0xe8, 0x2f, 0x33, 0x73, 0x90,
+  0x85, 0x82, 0x4c, 0xed, 0x54, 0xec, 0x12, 0x7c, 0xdb, 0x97, 0x24, 0x38, 0xe3, 0xae, 0xd5, 0x38,
+  0x65, 0x61, 0xcc, 0xe7, 0x21, 0x61, 0x10, 0x07, 0x64, 0x2d, 0x69, 0xb7, 0x22, 0x78, 0x1a, 0xb9,
+  0x04, 0x66, 0xc7, 0x00, 0xcc, 0xad, 0x4b, 0xd7, 0x26, 0xc4, 0x20, 0xa4, 0x1f, 0xa2, 0xba, 0xd7,
+  0xb1, 0xf3, 0x9e, 0x9d, 0x9d, 0x7f, 0x42, 0x33, 0x86, 0x11, 0xeb, 0xdf, 0x94, 0x45, 0x3b, 0x41,
+  0xf9, 0xc1, 0xec, 0x0b, 0xb0, 0xda, 0x2e, 0x6c, 0x5d, 0x0e, 0xdc, 0xc7, 0x37, 0xe8, 0xc5, 0x72,
+  0xba, 0xe3, 0x3a, 0x46, 0xfb, 0x35, 0x8f, 0x7b, 0x2d, 0x9b, 0xc8, 0x1a, 0xad, 0x50, 0x73, 0x3d,
+  0x9a, 0xe7, 0x4c, 0x24, 0x07, 0x33, 0x9e, 0x26, 0x2d, 0x40, 0xe7, 0x38, 0xde, 0x4f, 0xd0, 0xbe,
+  0x90, 0x13, 0x6b, 0x66, 0x58, 0xa9, 0xbf, 0xce, 0x60, 0x17, 0x34, 0x4b, 0x35, 0x7c, 0x31, 0x62,
+  0x52, 0x4c, 0x2c, 0x13, 0x72, 0x39, 0x51, 0x6e, 0xd7, 0xe9, 0x2a, 0x5b, 0xcc, 0x3a, 0xba, 0xb5,
+  0x07, 0x13, 0xae, 0xb4, 0xb1, 0xeb, 0x9e, 0x4e, 0x59, 0x6b, 0x60, 0xab, 0x56, 0x2b, 0xcb, 0xa8,
+  0xbe, 0x10, 0x71, 0x50, 0xd6, 0x94, 0x99, 0x7e, 0xa5, 0x90, 0xc5, 0x89, 0x38, 0xc3, 0x5c, 0xef,
+  0xa6, 0xb1, 0xae, 0xfe, 0x8a, 0x67, 0x6c, 0x0a, 0xc5, 0x5a, 0xc2, 0x72, 0xc9, 0x75, 0x38, 0x08,
+  0x46, 0xe3, 0xc2, 0xe9, 0x4a, 0x6b, 0xde, 0xe6, 0x6b, 0xbe, 0x11, 0xa1, 0x67, 0x94, 0x1b, 0x32,
+  0x61, 0x06, 0x3c, 0x23, 0xaa, 0xd5, 0x7f, 0x36, 0x93, 0xfa, 0x23, 0x1e, 0x52, 0xe5, 0x7b, 0x76,
+  0xdd, 0x46, 0x4e, 0xfd, 0x61, 0x75, 0x4a, 0x87, 0x24, 0xd0, 0x17, 0x3d, 0xfa, 0x8a, 0x5e, 0x0f,
+  0x57, 0x5b, 0xa5, 0x1f, 0x49, 0x81, 0xef, 0x72, 0xd9, 0x92, 0x19, 0xeb, 0x4b, 0x1f, 0x9f, 0x3c,
+  0xfc, 0x24, 0xc8, 0x2f, 0x37, 0x57, 0xab, 0x3b, 0xd0, 0x84, 0xeb, 0x1f, 0x1a, 0x75, 0xe1, 0x10,
+  0xcb, 0xca, 0xb8, 0x50, 0x5a, 0xe2, 0xd7, 0x5d, 0x02, 0x53, 0xe7, 0x9c, 0x82, 0x9f, 0xda, 0x0e,
+  0xd3, 0xbb, 0x4b, 0x38, 0xdf, 0x0f, 0x92, 0x5d, 0xd0, 0x31, 0x2c, 0x97, 0x4b, 0x4b, 0x35, 0x2d,
+  0xb1, 0xb9, 0xa3, 0x89, 0xd9, 0x98, 0x61, 0xf8, 0xfb, 0x04, 0x8e, 0xaf, 0xdc, 0x4e, 0x98, 0x02,
+  0x41, 0xbb, 0x27, 0xe8, 0xd2, 0x87, 0x58, 0x49, 0xeb, 0x1d, 0x48, 0xe5, 0x19, 0xd1, 0x05, 0x7e,
+  0x6b, 0x06, 0xf0, 0xe4, 0xe4, 0xe4, 0x10, 0xfa, 0x9d, 0xc2, 0xbe, 0x43, 0xaf, 0x5a, 0x5f, 0xfb,
+  0xb1, 0x9a, 0x84, 0x64, 0x88, 0x93, 0xf7, 0x8a, 0x82, 0xaf, 0x8a, 0xa9, 0x81, 0x7c, 0x0d, 0x7d,
+  0x12, 0x24, 0xad, 0xb9, 0x4c, 0x31, 0xe7, 0x78, 0x43, 0xab, 0xb2, 0x8a, 0x27, 0x65, 0x5c, 0x0e,
+  0x96, 0xaf, 0x35, 0xeb, 0x75, 0xb3, 0x53, 0x9f, 0xaa, 0x2a, 0x8a, 0x98, 0xca, 0xc0, 0xc9, 0xf0,
+  0x85, 0x83, 0xfd, 0x64, 0x00, 0x54, 0x28, 0x1b, 0xfa, 0x72, 0x06, 0xf6, 0xf4, 0x1e, 0xe1, 0xb7,
+  0x4b, 0x10, 0x62, 0xd4, 0x7d, 0x93, 0x31, 0x22, 0xee, 0x4c, 0xfc, 0xd2, 0xd9, 0xcf, 0x23, 0x69,
+  0xd7, 0xf0, 0x41, 0x93, 0xf4, 0xa0, 0xbc, 0x6d, 0xd5, 0xf5, 0xdb, 0xc1, 0x37, 0xb1, 0x5b, 0x5b,
+  0xe0, 0x24, 0x97, 0x61, 0x8b, 0x7b, 0xf3, 0x8c, 0x83, 0x08, 0x67, 0x3d, 0xab, 0xc1, 0x13, 0x48,
+  0xca, 0x31, 0xf3, 0x65, 0xfb, 0x06, 0x56, 0x5a, 0xcd, 0xc2, 0x71, 0x22, 0x1d, 0x83, 0x38, 0x86,
+  0x0c, 0xf0, 0x80, 0xdf, 0xbb, 0xb6, 0x66, 0x99, 0x59, 0x2d, 0x64, 0x4f, 0x0a, 0x09, 0x31, 0x86,
+  0x5e, 0x5c, 0xe3, 0xd0, 0x25, 0x15, 0x89, 0xad, 0x49, 0x1b, 0x4d, 0x14, 0x03, 0xe5, 0x0e, 0x19,
+  0x17, 0x1a, 0x52, 0x5a, 0x2d, 0x1a, 0x99, 0x78, 0x5e, 0x50, 0xcc, 0x92, 0x90, 0xe8, 0xe8, 0x9c,
+  0xda, 0xc9, 0x87, 0x83, 0x4f, 0x64, 0x83, 0x10, 0x53, 0x4a, 0xaa, 0x86, 0xee, 0xdc, 0x33, 0x60,
+  0x2c, 0xb9, 0x38, 0x31, 0x14, 0x39, 0x87, 0x7e, 0x25, 0xe0, 0xbb, 0x77, 0x70, 0xf4, 0xf0, 0xe4,
+  0xf0, 0x6e, 0xfb, 0x25, 0xf2, 0x2f, 0x75, 0xe8, 0x90, 0xd1, 0x24, 0xb1, 0x08, 0x8e, 0xa0, 0x8d,
+  0x66, 0x40, 0xb4, 0x15, 0xd1, 0x0c, 0x62, 0x4f, 0xd1, 0xa8, 0x53, 0x75, 0x79, 0x6b, 0x8e, 0x86,
+  0x32, 0x96, 0x31, 0x34, 0x7b, 0x39, 0x7e, 0x6f, 0xd9, 0x72, 0xb0, 0xb6, 0xb6, 0x08, 0xe2, 0xa5,
+  0x3c, 0xca, 0x68, 0x5c, 0x08, 0x5a, 0x1d, 0xf9, 0xae, 0xfb, 0xd9, 0x58, 0x8b, 0xef, 0x05, 0x29,
+  0xe6, 0xab, 0xaf, 0x6a, 0x63, 0xb0, 0xe0, 0x4f, 0xb3, 0xcf, 0x59, 0x2d, 0x26, 0xf6, 0x1a, 0xd9,
+  0x68, 0xc9, 0x14, 0x6a, 0x72, 0xb5, 0xe5, 0x03, 0x62, 0x25, 0xa3, 0xed, 0xd5, 0xf8, 0x46, 0xfb,
+  0xde, 0xa3, 0x29, 0xbe, 0xdf, 0x52, 0x6c, 0xca, 0xb1, 0x3e, 0xd4, 0x43, 0xaf, 0x65, 0xf0, 0x63,
+  0x38, 0x1c, 0x51, 0xc3, 0x34, 0xf5, 0x54, 0x18, 0x76, 0xb6, 0xab, 0xb9, 0x6a, 0x67, 0xfd, 0x90,
+  0xac, 0xf4, 0x65, 0x29, 0x52, 0x49, 0x93, 0xc0, 0xea, 0x8d, 0x37, 0x67, 0x3b, 0x6b, 0x58, 0x5b,
+  0x17, 0xb5, 0x68, 0xe6, 0xb5, 0xef, 0xf4, 0x3a, 0xf8, 0xbd, 0x2b, 0x88, 0x40, 0xeb, 0x93, 0x13,
+  0xcc, 0x51, 0x1a, 0x3f, 0xf8, 0x58, 0x79, 0xc5, 0xe7, 0xbe, 0x3a, 0x29, 0xdf, 0x19, 0xef, 0xf6,
+  0xdd, 0xf7, 0x26, 0xbb, 0x7d, 0xf7, 0x39, 0xee, 0x7f, 0x01, 0xd9, 0x2d, 0xaf, 0x1b, 0x9f, 0x2b,
+  0x00, 0x00,
+};
@@ -0,0 +1,271 @@
+/*
+ * Simulação no computador: medições de desempenho do sketch. Os tempos são do computador, não do
+ * ESP32 (um Xtensa a 240 MHz é da ordem de 10 a 30 vezes mais lento); servem para comparar
+ * versões e ordens de grandeza. Tamanhos das respostas são os do sketch; alocações são as do
+ * operator new do computador (veja simulacao.h). Cada medição roda em um processo próprio, pois o
+ * sketch guarda o estado em variáveis globais.
+ *
+ * Uso: benchmark [dados|ringbuffer|serie|regras|flash|alertas]   (sem argumento: todas)
+ */
+#include <simulacao.h>
+
+#include "Monitoramento.c"
+
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+double agora() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Impede que o compilador descarte o resultado de um laço medido
+volatile uint64_t sumidouro;
+
+const uint32_t EPOCH = 1750000000;
+
+// Leituras a cada 10 s do gerador sintético da simulação (ciclo diário, ruído, resolução 0,1)
+std::vector<Amostra> leiturasSinteticas(size_t quantidade, bool centesimos = false) {
+  std::vector<Amostra> leituras;
+  std::mt19937 gerador(5);
+  for (size_t i = 0; i < quantidade; i++) {
+    float temperatura, umidade;
+    simulacao::leituraSintetica(DHTPIN, i * 10.0, temperatura, umidade);
+    int32_t ajuste = centesimos ? (int32_t)(gerador() % 10) : 0; // Sensor com resolução de 0,01
+    leituras.push_back({EPOCH + (uint32_t)i * 10, (int16_t)(paraCentesimos(temperatura) + ajuste),
+                        (uint16_t)(paraCentesimos(umidade) + ajuste)});
+  }
+  return leituras;
+}
+
+/*
+ * /dados: serialização em fluxo (EscritorJson), em bytes/s e alocações por resposta
+ */
+void medirDados() {
+  for (const Amostra& leitura : leiturasSinteticas(3 * 8640)) registrarAmostra(leitura, false);
+  server.on("/dados", handleDados);
+  const char* consultas[] = {"/dados", "/dados?since=0&sinceHoras=0", "/dados?formato=bin"};
+  for (const char* consulta : consultas) {
+    WebServer::Requisicao requisicao = simulacao::requisicao(consulta);
+    server.atender(requisicao);         // Aquece caches e a capacidade do corpo
+    const int repeticoes = 100000;
+    double segundos = 0;
+    uint64_t bytes = 0, alocacoes = 0;
+    for (int i = 0; i < repeticoes; i++) {
+      const WebServer::Resposta& resposta = server.atender(requisicao);
+      segundos += resposta.segundos;
+      bytes += resposta.corpo.size();
+      alocacoes += resposta.alocacoes;
+    }
+    printf("dados  %-30s %5.0f bytes  %6.2f µs/resposta  %6.1f MB/s  %.2f alocações/resposta\n", consulta,
+           (double)bytes / repeticoes, segundos / repeticoes * 1e6, bytes / segundos / 1e6, (double)alocacoes / repeticoes);
+  }
+
+  // Só o escritor, com destino vazio: números e texto fixo
+  EscritorJson json;
+  json.saida = [](const char*, size_t tamanho) { sumidouro += tamanho; };
+  sumidouro = 0;
+  uint64_t alocacoesAntes = simulacao::alocacoes;
+  double inicio = agora();
+  for (int i = 0; i < 10000000; i++) {
+    json.escreverCentesimos(i % 14000 - 4000, 2);
+    json.escrever(",");
+  }
+  json.descarregar();
+  double segundos = agora() - inicio;
+  printf("dados  EscritorJson (centésimos)        %6.1f MB/s  %.1f ns/valor  %llu alocações\n",
+         sumidouro / segundos / 1e6, segundos / 10000000 * 1e9,
+         (unsigned long long)(simulacao::alocacoes - alocacoesAntes));
+}
+
+/*
+ * RingBuffer: push, acesso por índice e iteração
+ */
+void medirRingBuffer() {
+  static RingBuffer<Amostra, 1024> buffer;
+  const int operacoes = 50000000;
+  Amostra amostra = {EPOCH, 2450, 5000};
+  double inicio = agora();
+  for (int i = 0; i < operacoes; i++) {
+    amostra.epoch++;
+    buffer.push(amostra);
+  }
+  double push = (agora() - inicio) / operacoes;
+
+  uint64_t soma = 0;
+  inicio = agora();
+  for (int i = 0; i < operacoes; i++) soma += buffer[i & 1023].epoch;
+  double indice = (agora() - inicio) / operacoes;
+
+  inicio = agora();
+  for (int volta = 0; volta < operacoes / 1024; volta++) {
+    for (const Amostra& lida : buffer) soma += lida.temperatura;
+  }
+  double iteracao = (agora() - inicio) / (operacoes / 1024 * 1024);
+  sumidouro = soma;
+  printf("ringbuffer  push %.2f ns  operator[] %.2f ns  iteração %.2f ns por elemento\n", push * 1e9, indice * 1e9,
+         iteracao * 1e9);
+}
+
+/*
+ * SerieComprimida: bits por leitura e vazão de codificação e decodificação
+ */
+void medirSerie() {
+  struct Caso {
+    const char* nome;
+    std::vector<Amostra> leituras;
+  };
+  std::vector<Caso> casos = {{"DHT22 (0,1, ruído)", leiturasSinteticas(200000)},
+                             {"resolução 0,01", leiturasSinteticas(200000, true)},
+                             {"constante", std::vector<Amostra>(200000, Amostra{0, 2450, 5000})}};
+  for (size_t i = 0; i < casos.back().leituras.size(); i++) casos.back().leituras[i].epoch = EPOCH + i * 10;
+
+  for (const Caso& caso : casos) {
+    static SerieComprimida<32768, 1024> serie;
+    serie = SerieComprimida<32768, 1024>();
+    double inicio = agora();
+    for (const Amostra& leitura : caso.leituras) serie.push(leitura);
+    double codificacao = agora() - inicio;
+
+    uint64_t soma = 0;
+    const int voltas = 20;
+    inicio = agora();
+    for (int volta = 0; volta < voltas; volta++) {
+      for (const Amostra& lida : serie) soma += lida.temperatura;
+    }
+    double decodificacao = agora() - inicio;
+    sumidouro = soma;
+    printf("serie  %-20s %5.2f bits/leitura  %6u leituras em 32 KB (%.1f dias)  codifica %5.1f M/s  decodifica %5.1f M/s\n",
+           caso.nome, serie.centesimosDeBitPorAmostra() / 100.0, (unsigned)serie.size(), serie.size() / 8640.0,
+           caso.leituras.size() / codificacao / 1e6, (double)serie.size() * voltas / decodificacao / 1e6);
+  }
+}
+
+/*
+ * Regras: custo de avaliar cada leitura com 3 (padrão) e 32 regras (MAX_REGRAS)
+ */
+void medirRegras() {
+  filaAlertas = xQueueCreate(TAMANHO_FILA_ALERTAS, sizeof(Alerta));
+  std::vector<Amostra> leituras = leiturasSinteticas(100000);
+  for (int quantidade : {3, MAX_REGRAS}) {
+    numRegras = quantidade;
+    for (int i = 3; i < quantidade; i++) { // Metade de limite, metade de taxa, com durações variadas
+      bool taxa = i % 2;
+      regras[i] = {"Regra", 0, (uint8_t)(i % 4 < 2 ? METRICA_TEMPERATURA : METRICA_UMIDADE), taxa ? REGRA_TAXA : REGRA_LIMITE,
+                   (int8_t)(i % 3 ? 1 : -1), taxa ? 20 + i : 2000 + 50 * i, 50, (uint32_t)(60 * (1 + i % 20)),
+                   (uint32_t)(i % 5 * 60), true};
+    }
+    canais[0].historico = RingBuffer<Amostra, capacidadeCanal>();
+    Alerta descartado;
+    double inicio = agora();
+    for (const Amostra& leitura : leituras) {
+      canais[0].registrar(leitura);
+      avaliarRegras(0, leitura);
+      while (xQueueReceive(filaAlertas, &descartado, 0) == pdTRUE) {}
+    }
+    double segundos = agora() - inicio;
+    printf("regras  %2d regras  %.0f ns por leitura (inclui registrar no canal)\n", quantidade,
+           segundos / leituras.size() * 1e9);
+  }
+}
+
+/*
+ * Flash: bytes entregues ao LittleFS por leitura e tempo de recuperação com 1 milhão de leituras.
+ * Conta apenas a carga útil passada a File::write (blocos com CRC e janelas agregadas), não os
+ * metadados do LittleFS nem as regravações de blocos da flash por cópia na escrita.
+ */
+void medirFlash() {
+  simulacao::serialSilenciosa = true;
+  LittleFS.begin(true);
+  const size_t leituras = 1000000;
+  pid_t filho = fork();                 // Grava em um processo; recupera em outro, como após um reinício
+  if (filho == 0) {
+    recuperarHistorico();
+    double inicio = agora();
+    for (const Amostra& leitura : leiturasSinteticas(leituras)) registrarAmostra(leitura, true);
+    double segundos = agora() - inicio;
+    printf("flash  %zu leituras: %.2f bytes de carga útil por leitura de %zu bytes (%.2fx, sem metadados do LittleFS), "
+           "%.2f µs por leitura\n",
+           leituras, (double)simulacao::bytesGravadosFlash / leituras, sizeof(Amostra),
+           (double)simulacao::bytesGravadosFlash / leituras / sizeof(Amostra), segundos / leituras * 1e6);
+    simulacao::encerrar(0);
+  }
+  waitpid(filho, NULL, 0);
+  double inicio = agora();
+  recuperarHistorico();
+  double segundos = agora() - inicio;
+  uint64_t retidas = 0;
+  File diretorio = LittleFS.open(DIRETORIO_HISTORICO);
+  for (File arquivo = diretorio.openNextFile(); arquivo; arquivo = diretorio.openNextFile()) {
+    if (strstr(arquivo.name(), ".seg")) retidas += arquivo.size() / sizeof(BlocoHistorico) * AMOSTRAS_POR_BLOCO;
+  }
+  printf("flash  recuperação: %u de %llu leituras retidas reaplicadas, %llu bytes lidos, %.1f ms no computador\n",
+         (unsigned)historico.total(), (unsigned long long)retidas, (unsigned long long)simulacao::bytesLidosFlash.load(),
+         segundos * 1e3);
+}
+
+/*
+ * Alertas: o loop continua atendendo enquanto a tarefa de alertas espera o Telegram
+ */
+void medirAlertas() {
+  simulacao::serialSilenciosa = true;
+  simulacao::latenciaTelegramMs = 800;
+  simulacao::fonteLeituras = [](uint8_t, double, float& temperatura, float& umidade) {
+    temperatura = 20;
+    umidade = 50;
+    return true;
+  };
+  setup();
+  Amostra leitura = {epochAtual(), 3000, 5000};
+  unsigned long maiorIntervalo = 0, anterior = millis();
+  unsigned long passagens = 0;
+  for (int alerta = 0; alerta < 100; alerta++) {
+    enfileirarAlerta(regras[0], leitura, 3000, false);
+    unsigned long fim = millis() + 1000;
+    while (millis() < fim) {
+      loop();
+      passagens++;
+      maiorIntervalo = std::max(maiorIntervalo, millis() - anterior);
+      anterior = millis();
+    }
+  }
+  printf("alertas  %lu mensagens de %lu ms: %lu passagens do loop, maior intervalo entre passagens %lu ms "
+         "(um envio síncrono pararia o loop por %lu ms)\n",
+         (unsigned long)simulacao::mensagensTelegram.size(), simulacao::latenciaTelegramMs, passagens, maiorIntervalo,
+         simulacao::latenciaTelegramMs);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::map<std::string, void (*)()> medicoes = {
+      {"dados", medirDados}, {"ringbuffer", medirRingBuffer}, {"serie", medirSerie},
+      {"regras", medirRegras},
+      {"flash", medirFlash}, {"alertas", medirAlertas},
+  };
+  if (argc == 2) {
+    auto medicao = medicoes.find(argv[1]);
+    if (medicao == medicoes.end()) {
+      fprintf(stderr, "Medição desconhecida: %s\n", argv[1]);
+      return 2;
+    }
+    medicao->second();
+    simulacao::encerrar(0);
+  }
+  for (const auto& medicao : medicoes) {
+    fflush(stdout);
+    pid_t filho = fork();
+    if (filho == 0) {
+      medicao.second();
+      simulacao::encerrar(0);
+    }
+    waitpid(filho, NULL, 0);
+  }
+  simulacao::encerrar(0);
+}
@@ -0,0 +1,111 @@
+/*
+ * Simulação no computador: substitui o núcleo Arduino do ESP32 (String, Serial, millis(), micros(),
+ * delay(), ESP) e a parte do FreeRTOS usada pelo sketch (filas e tarefas). millis() é o relógio
+ * virtual da simulação; micros() mede o tempo real do host, para que os histogramas de latência
+ * do sketch reflitam o custo dos trechos medidos. Veja simulacao.h.
+ */
+#pragma once
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+using std::isinf;
+using std::isnan;
+using std::signbit;
+
+#define PROGMEM
+typedef const char* PGM_P;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+uint32_t esp_random();
+
+// String do Arduino sobre std::string (apenas o que o sketch usa)
+class String {
+ public:
+  String() {}
+  String(const char* texto) : texto(texto ? texto : "") {}
+  String(const std::string& texto) : texto(texto) {}
+  String(char c) : texto(1, c) {}
+  String(int valor) : texto(std::to_string(valor)) {}
+  String(unsigned int valor) : texto(std::to_string(valor)) {}
+  String(long valor) : texto(std::to_string(valor)) {}
+  String(unsigned long valor) : texto(std::to_string(valor)) {}
+  String(float valor, unsigned int casas = 2) : texto(formatar(valor, casas)) {}
+  String(double valor, unsigned int casas = 2) : texto(formatar(valor, casas)) {}
+
+  const char* c_str() const { return texto.c_str(); }
+  unsigned int length() const { return texto.size(); }
+  long toInt() const { return strtol(texto.c_str(), NULL, 10); }
+  float toFloat() const { return strtof(texto.c_str(), NULL); }
+
+  String& operator+=(const String& outro) { texto += outro.texto; return *this; }
+  String& operator+=(const char* outro) { texto += outro; return *this; }
+  String& operator+=(char c) { texto += c; return *this; }
+  friend String operator+(String a, const String& b) { return a += b; }
+  friend String operator+(String a, const char* b) { return a += b; }
+  friend String operator+(const char* a, const String& b) { return String(a) += b; }
+  bool operator==(const String& outro) const { return texto == outro.texto; }
+  bool operator==(const char* outro) const { return texto == outro; }
+  bool operator!=(const String& outro) const { return texto != outro.texto; }
+  bool operator!=(const char* outro) const { return texto != outro; }
+
+ private:
+  static std::string formatar(double valor, unsigned int casas) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)casas, valor);
+    return buffer;
+  }
+  std::string texto;
+};
+
+// Serial: escreve em stderr (silenciável com simulacao::serialSilenciosa)
+class SerialSimulada {
+ public:
+  void begin(unsigned long) {}
+  void print(const char* texto);
+  void print(const String& texto) { print(texto.c_str()); }
+  void println(const char* texto = "") { print(texto); print("\n"); }
+  void println(const String& texto) { println(texto.c_str()); }
+  template <typename T>
+  void println(const T& valor) { println(valor.toString()); }
+  void printf(const char* formato, ...) __attribute__((format(printf, 2, 3)));
+};
+extern SerialSimulada Serial;
+
+class EspSimulado {
+ public:
+  uint32_t getFreeHeap() { return 180000; }
+  uint32_t getMinFreeHeap() { return 160000; }
+};
+extern EspSimulado ESP;
+
+/*
+ * FreeRTOS: tarefas são threads do host, mas apenas uma executa por vez (como em um único núcleo).
+ * Uma tarefa só cede a vez ao bloquear (vTaskDelay ou fila vazia); o tempo só avança quando o
+ * loop principal bloqueia e todas as tarefas estão esperando.
+ */
+typedef void* QueueHandle_t;
+typedef void* TaskHandle_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t UBaseType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms)) // Tick de 1 ms, como no ESP32
+
+QueueHandle_t xQueueCreate(UBaseType_t tamanho, UBaseType_t tamanhoItem);
+BaseType_t xQueueSend(QueueHandle_t fila, const void* item, TickType_t espera);
+BaseType_t xQueueReceive(QueueHandle_t fila, void* item, TickType_t espera);
+BaseType_t xTaskCreatePinnedToCore(void (*funcao)(void*), const char* nome, uint32_t pilha, void* parametro,
+                                   UBaseType_t prioridade, TaskHandle_t* tarefa, BaseType_t nucleo);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
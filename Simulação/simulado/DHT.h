@@ -0,0 +1,22 @@
+// Simulação no computador: o DHT22 devolve valores da fonte de leituras da simulação (simulacao.h)
+#pragma once
+#include <Arduino.h>
+
+#define DHT11 11
+#define DHT22 22
+
+class DHT {
+ public:
+  DHT(uint8_t pino, uint8_t tipo) : pino(pino) { (void)tipo; }
+  void begin() {}
+  float readTemperature();
+  float readHumidity();
+
+ private:
+  void ler();                          // Como a biblioteca: uma nova transação no máximo a cada 2 s
+  uint8_t pino;
+  bool lida = false;
+  unsigned long instante = 0;
+  float temperatura = NAN;
+  float umidade = NAN;
+};
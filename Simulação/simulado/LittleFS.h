@@ -0,0 +1,33 @@
+// Simulação no computador: LittleFS sobre um diretório do host (simulacao::diretorioFlash)
+#pragma once
+#include <Arduino.h>
+#include <memory>
+
+class File {
+ public:
+  explicit operator bool() const { return estado != nullptr; }
+  size_t read(uint8_t* destino, size_t tamanho);
+  size_t write(const uint8_t* dados, size_t tamanho);
+  size_t write(uint8_t byte) { return write(&byte, 1); }
+  bool seek(uint32_t posicao);
+  size_t size() const;
+  const char* name() const;
+  File openNextFile();               // Próxima entrada de um diretório aberto
+  void close() { estado.reset(); }
+
+ private:
+  friend class LittleFSSimulado;
+  struct Estado;
+  std::shared_ptr<Estado> estado;
+};
+
+class LittleFSSimulado {
+ public:
+  bool begin(bool formatarSeFalhar = false);
+  bool mkdir(const char* caminho);
+  bool exists(const char* caminho);
+  bool remove(const char* caminho);
+  bool rename(const char* origem, const char* destino);
+  File open(const char* caminho, const char* modo = "r");
+};
+extern LittleFSSimulado LittleFS;
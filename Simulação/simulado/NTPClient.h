@@ -0,0 +1,18 @@
+// Simulação no computador: NTP que responde a partir de simulacao::ntpDisponivelAposMs
+#pragma once
+#include <Arduino.h>
+#include <WiFiUdp.h>
+
+class NTPClient {
+ public:
+  NTPClient(WiFiUDP&, const char*, long deslocamento, unsigned long) : deslocamento(deslocamento) {}
+  void begin() {}
+  bool update();
+  bool isTimeSet() const { return sincronizado; }
+  // Como na biblioteca real: sem resposta, devolve apenas o deslocamento somado ao tempo ligado
+  unsigned long getEpochTime() const;
+
+ private:
+  long deslocamento;
+  bool sincronizado = false;
+};
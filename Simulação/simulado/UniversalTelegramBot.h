@@ -0,0 +1,11 @@
+// Simulação no computador: cada mensagem leva simulacao::latenciaTelegramMs de tempo virtual e
+// fica registrada em simulacao::mensagensTelegram
+#pragma once
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+
+class UniversalTelegramBot {
+ public:
+  UniversalTelegramBot(const String&, WiFiClientSecure&) {}
+  bool sendMessage(const String& chat, const String& texto, const String& formato = "");
+};
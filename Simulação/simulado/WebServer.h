@@ -0,0 +1,72 @@
+/*
+ * Simulação no computador: WebServer do ESP32 sem rede. O programa de simulação enfileira
+ * requisições (enfileirar) que o sketch atende em server.handleClient(), ou as atende na hora
+ * (atender). Rotas registradas para um método só atendem esse método; as demais, qualquer um. As respostas ficam em memória; server.client() entrega ao handler uma ponta de um
+ * socketpair, cuja outra ponta fica na resposta para o programa ler o que o sketch enviar depois.
+ */
+#pragma once
+#include <Arduino.h>
+#include <WiFi.h>
+#include <deque>
+#include <functional>
+#include <map>
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+class WebServer {
+ public:
+  typedef std::function<void()> THandlerFunction;
+
+  struct Requisicao {
+    HTTPMethod metodo = HTTP_GET;
+    std::string rota;
+    std::map<std::string, std::string> argumentos;
+    std::map<std::string, std::string> cabecalhos;
+  };
+
+  struct Resposta {
+    int codigo = 0;
+    std::string tipo;
+    std::map<std::string, std::string> cabecalhos;
+    std::string corpo;                 // Tudo o que foi enviado por send()/sendContent()
+    int conexao = -1;                  // Ponta do cliente, se o handler manteve a conexão (fechá-la cabe ao programa)
+    double segundos = 0;               // Tempo real gasto no handler
+    uint64_t alocacoes = 0;            // Alocações no heap durante o handler
+    uint64_t bytesAlocados = 0;
+  };
+
+  explicit WebServer(int) {}
+  void on(const String& rota, THandlerFunction handler) { on(rota, HTTP_ANY, handler); }
+  void on(const String& rota, HTTPMethod metodo, THandlerFunction handler);
+  void begin() {}
+  void handleClient();
+  void collectHeaders(const char* nomes[], size_t quantidade) { (void)nomes; (void)quantidade; }
+
+  HTTPMethod method() const { return requisicao ? requisicao->metodo : HTTP_ANY; }
+  bool hasArg(const String& nome) const;
+  String arg(const String& nome) const;
+  String header(const String& nome) const;
+  void setContentLength(size_t) {}
+  void sendHeader(const String& nome, const String& valor, bool primeiro = false);
+  void send(int codigo, const char* tipo = NULL, const String& conteudo = String());
+  void send_P(int codigo, PGM_P tipo, PGM_P conteudo, size_t tamanho);
+  void sendContent(const char* dados, size_t tamanho);
+  void sendContent(const String& dados) { sendContent(dados.c_str(), dados.length()); }
+  WiFiClient client();
+
+  // Interface da simulação
+  void enfileirar(const Requisicao& requisicao) { fila.push_back(requisicao); }
+  const Resposta& atender(const Requisicao& requisicao); // Válida até a próxima requisição
+  size_t pendentes() const { return fila.size(); }
+  std::function<void(const Resposta&)> aoResponder;      // Chamada após cada requisição da fila
+
+ private:
+  std::map<std::pair<std::string, HTTPMethod>, THandlerFunction> rotas;
+  std::deque<Requisicao> fila;
+  const Requisicao* requisicao = NULL;
+  Resposta resposta;
+  WiFiClient conexao;                  // Ponta do sketch, se server.client() foi chamado
+  int pontaPar = -1;                   // Ponta do cliente correspondente
+};
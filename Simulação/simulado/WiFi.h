@@ -0,0 +1,39 @@
+// Simulação no computador: Wi-Fi sempre conectado e WiFiClient sobre um socket local do host
+#pragma once
+#include <Arduino.h>
+#include <memory>
+
+#define WL_CONNECTED 3
+
+class IPAddress {
+ public:
+  String toString() const { return "127.0.0.1"; }
+};
+
+class WiFiSimulado {
+ public:
+  void begin(const char*, const char*) {}
+  int status() { return WL_CONNECTED; }
+  IPAddress localIP() { return IPAddress(); }
+  void setSleep(bool) {}
+};
+extern WiFiSimulado WiFi;
+
+// Conexão TCP aceita pelo WebServer simulado: uma ponta de um socketpair; a outra fica com o
+// cliente simulado (simulacao.h). Cópias compartilham a conexão, como no ESP32.
+class WiFiClient {
+ public:
+  WiFiClient() {}
+  explicit WiFiClient(int descritor);
+  int fd() const { return conexao ? conexao->descritor : -1; }
+  bool connected();
+  void stop() { conexao.reset(); }
+
+ private:
+  friend class WebServer;              // Sabe se o handler guardou uma cópia da conexão
+  struct Conexao {
+    int descritor;
+    ~Conexao();
+  };
+  std::shared_ptr<Conexao> conexao;
+};
@@ -0,0 +1,8 @@
+// Simulação no computador: o bot do Telegram simulado não abre conexões
+#pragma once
+#include <WiFi.h>
+
+class WiFiClientSecure : public WiFiClient {
+ public:
+  void setInsecure() {}
+};
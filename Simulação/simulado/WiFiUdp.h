@@ -0,0 +1,5 @@
+// Simulação no computador: o NTPClient simulado não usa a rede
+#pragma once
+#include <WiFi.h>
+
+class WiFiUDP {};
@@ -0,0 +1,8 @@
+// Simulação no computador: maior bloco livre fixo (o heap do host não é o do ESP32)
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+
+inline size_t heap_caps_get_largest_free_block(uint32_t) { return 110592; }
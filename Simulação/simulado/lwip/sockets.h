@@ -0,0 +1,4 @@
+// Simulação no computador: send() e MSG_DONTWAIT vêm dos sockets do host
+#pragma once
+#include <cerrno>
+#include <sys/socket.h>
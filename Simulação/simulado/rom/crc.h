@@ -0,0 +1,6 @@
+// Simulação no computador: mesmo CRC32 (polinômio refletido 0xEDB88320) da ROM do ESP32
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+uint32_t crc32_le(uint32_t crc, const uint8_t* dados, size_t tamanho);
@@ -0,0 +1,572 @@
+/*
+ * Simulação no computador: implementação das bibliotecas simuladas (os cabeçalhos de simulado/) e do relógio
+ * virtual. Todo o código do sketch roda com a trava "cpu" adquirida, seja no loop principal, seja
+ * em uma tarefa; quem bloqueia a libera, como a troca de contexto de um núcleo único.
+ */
+#include "simulacao.h"
+
+#include <DHT.h>
+#include <LittleFS.h>
+#include <NTPClient.h>
+#include <UniversalTelegramBot.h>
+#include <WebServer.h>
+#include <WiFi.h>
+#include <dirent.h>
+#include <rom/crc.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace simulacao {
+
+FonteLeituras fonteLeituras = leituraSintetica;
+double probabilidadeFalhaSensor = 0;
+uint32_t epochInicial = 1750000000;       // 15/06/2025 15:06:40 UTC
+unsigned long ntpDisponivelAposMs = 0;
+unsigned long latenciaTelegramMs = 800;
+bool telegramFalhando = false;
+std::vector<std::string> mensagensTelegram;
+std::string diretorioFlash;
+std::atomic<uint64_t> bytesGravadosFlash(0);
+std::atomic<uint64_t> bytesLidosFlash(0);
+bool serialSilenciosa = false;
+std::atomic<uint64_t> alocacoes(0);
+std::atomic<uint64_t> bytesAlocados(0);
+
+/*
+ * Escalonador: "executando" conta as tarefas que ainda não bloquearam. O loop principal, ao
+ * bloquear, espera que todas bloqueiem e só então avança o relógio até o prazo mais próximo,
+ * acordando as tarefas que venceram.
+ */
+namespace {
+
+struct Fila {
+  size_t capacidade;
+  size_t tamanhoItem;
+  std::vector<uint8_t> itens;             // Buffer circular alocado na criação
+  size_t inicio = 0;
+  size_t quantidade = 0;
+};
+
+struct Espera {
+  uint64_t prazo;                         // Tempo virtual (ms) em que a tarefa acorda sozinha
+  Fila* fila;                             // Fila esperada (ou NULL)
+  bool acordada;
+};
+
+std::mutex cpu;
+std::unique_lock<std::mutex> travaPrincipal(cpu); // O loop principal começa com a CPU
+std::condition_variable mudou;
+const std::thread::id principal = std::this_thread::get_id();
+uint64_t agoraMs = 0;
+int executando = 0;
+std::vector<Espera*> esperas;
+pid_t donoFlashTemporaria = 0;           // Processo que criou a partição temporária (a apaga ao sair)
+const auto inicioReal = std::chrono::steady_clock::now();
+std::mt19937 ruido(12345);                // Ruído determinístico das leituras sintéticas
+std::bernoulli_distribution falha;
+
+struct Inicializacao {
+  Inicializacao() {
+    signal(SIGPIPE, SIG_IGN);             // Cliente que fechou a conexão: send() retorna EPIPE
+    esperas.reserve(16);
+  }
+} inicializacao;
+
+bool naTarefa() { return std::this_thread::get_id() != principal; }
+
+void acordar(Espera* espera) {
+  espera->acordada = true;
+  executando++;
+  mudou.notify_all();
+}
+
+// Bloqueia a tarefa atual até o prazo ou até um xQueueSend na fila (chamada com a CPU)
+void bloquearTarefa(uint64_t prazo, Fila* fila) {
+  std::unique_lock<std::mutex> trava(cpu, std::adopt_lock);
+  Espera espera = {prazo, fila, false};
+  esperas.push_back(&espera);
+  executando--;
+  mudou.notify_all();
+  mudou.wait(trava, [&] { return espera.acordada; });
+  esperas.erase(std::find(esperas.begin(), esperas.end(), &espera));
+  trava.release();                        // A tarefa continua com a CPU
+}
+
+// Bloqueia o loop principal até o prazo ou até a fila ter um item; o tempo avança aqui
+void bloquearPrincipal(uint64_t prazo, Fila* fila) {
+  for (;;) {
+    mudou.wait(travaPrincipal, [] { return executando == 0; });
+    if (fila && fila->quantidade > 0) return;
+    uint64_t proximo = UINT64_MAX;
+    for (Espera* espera : esperas) {
+      if (!espera->acordada) proximo = std::min(proximo, espera->prazo);
+    }
+    if (proximo > prazo) {
+      agoraMs = std::max(agoraMs, prazo);
+      return;
+    }
+    agoraMs = std::max(agoraMs, proximo);
+    for (Espera* espera : esperas) {
+      if (!espera->acordada && espera->prazo <= agoraMs) acordar(espera);
+    }
+  }
+}
+
+void bloquear(unsigned long ms, Fila* fila) {
+  uint64_t prazo = ms == portMAX_DELAY ? UINT64_MAX : agoraMs + ms;
+  if (naTarefa()) bloquearTarefa(prazo, fila);
+  else bloquearPrincipal(prazo, fila);
+}
+
+std::string caminhoHost(const char* caminho) { return diretorioFlash + caminho; }
+
+}  // namespace
+
+uint64_t agoraUs() { return agoraMs * 1000; }
+
+void avancar(unsigned long ms) { bloquear(ms, NULL); }
+
+void encerrar(int codigo) {
+  fflush(stdout);
+  fflush(stderr);
+  if (donoFlashTemporaria == getpid()) std::filesystem::remove_all(diretorioFlash);
+  _exit(codigo);                          // As tarefas estão bloqueadas e nunca retornam
+}
+
+// Ciclo diário (mínimo às 6 h UTC, máximo às 18 h) com ruído, na resolução de 0,1 do DHT22
+bool leituraSintetica(uint8_t pino, double segundos, float& temperatura, float& umidade) {
+  std::normal_distribution<double> variacao(0, 0.15);
+  double ciclo = std::cos(2 * M_PI * (std::fmod(epochInicial + segundos, 86400.0) - 6 * 3600) / 86400.0);
+  temperatura = std::round((24.0 + pino * 0.1 - 4.0 * ciclo + variacao(ruido)) * 10) / 10;
+  umidade = std::round((55.0 + 10.0 * ciclo + variacao(ruido)) * 10) / 10;
+  return true;
+}
+
+namespace {
+
+struct PontoTraco {
+  double segundos;
+  float temperatura;
+  float umidade;
+};
+std::vector<PontoTraco> traco;
+
+// Repete o traço quando o tempo simulado passa do fim; cada ponto vale até o seguinte
+bool leituraTraco(uint8_t, double segundos, float& temperatura, float& umidade) {
+  double duracao = traco.back().segundos - traco.front().segundos + 1;
+  double t = traco.front().segundos + std::fmod(segundos, duracao);
+  auto ponto = std::upper_bound(traco.begin(), traco.end(), t,
+                                [](double t, const PontoTraco& p) { return t < p.segundos; });
+  if (ponto != traco.begin()) --ponto;
+  temperatura = ponto->temperatura;
+  umidade = ponto->umidade;
+  return !std::isnan(temperatura) && !std::isnan(umidade);
+}
+
+}  // namespace
+
+bool carregarTraco(const char* caminho) {
+  std::ifstream arquivo(caminho);
+  std::string linha;
+  traco.clear();
+  while (std::getline(arquivo, linha)) {
+    PontoTraco ponto;
+    char* fim;
+    ponto.segundos = strtod(linha.c_str(), &fim);
+    if (fim == linha.c_str() || *fim != ',') continue; // Cabeçalho ou linha inválida
+    ponto.temperatura = strtof(fim + 1, &fim);
+    if (*fim != ',') continue;
+    ponto.umidade = strtof(fim + 1, &fim);
+    traco.push_back(ponto);
+  }
+  if (traco.empty()) return false;
+  std::stable_sort(traco.begin(), traco.end(),
+                   [](const PontoTraco& a, const PontoTraco& b) { return a.segundos < b.segundos; });
+  fonteLeituras = leituraTraco;
+  return true;
+}
+
+WebServer::Requisicao requisicao(const std::string& url, HTTPMethod metodo) {
+  auto decodificar = [](const std::string& texto) {
+    std::string resultado;
+    for (size_t i = 0; i < texto.size(); i++) {
+      if (texto[i] == '+') resultado += ' ';
+      else if (texto[i] == '%' && i + 2 < texto.size()) {
+        resultado += (char)strtol(texto.substr(i + 1, 2).c_str(), NULL, 16);
+        i += 2;
+      } else resultado += texto[i];
+    }
+    return resultado;
+  };
+  WebServer::Requisicao resultado;
+  resultado.metodo = metodo;
+  size_t interrogacao = url.find('?');
+  resultado.rota = url.substr(0, interrogacao);
+  std::istringstream consulta(interrogacao == std::string::npos ? "" : url.substr(interrogacao + 1));
+  std::string par;
+  while (std::getline(consulta, par, '&')) {
+    size_t igual = par.find('=');
+    std::string nome = decodificar(par.substr(0, igual));
+    resultado.argumentos[nome] = igual == std::string::npos ? "" : decodificar(par.substr(igual + 1));
+  }
+  return resultado;
+}
+
+void apagarFlash() {
+  std::error_code erro;
+  std::filesystem::remove_all(diretorioFlash, erro);
+  std::filesystem::create_directories(diretorioFlash, erro);
+}
+
+}  // namespace simulacao
+
+using namespace simulacao;
+
+/*
+ * Núcleo Arduino e FreeRTOS
+ */
+SerialSimulada Serial;
+EspSimulado ESP;
+WiFiSimulado WiFi;
+LittleFSSimulado LittleFS;
+
+unsigned long millis() { return agoraMs; }
+
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - inicioReal).count();
+}
+
+void delay(unsigned long ms) { bloquear(ms, NULL); }
+
+uint32_t esp_random() {
+  static std::mt19937 gerador(std::random_device{}());
+  return gerador();
+}
+
+void SerialSimulada::print(const char* texto) {
+  if (!serialSilenciosa) fputs(texto, stderr);
+}
+
+void SerialSimulada::printf(const char* formato, ...) {
+  if (serialSilenciosa) return;
+  va_list argumentos;
+  va_start(argumentos, formato);
+  vfprintf(stderr, formato, argumentos);
+  va_end(argumentos);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t tamanho, UBaseType_t tamanhoItem) {
+  Fila* fila = new Fila{tamanho, tamanhoItem, std::vector<uint8_t>(tamanho * tamanhoItem)};
+  return fila;
+}
+
+BaseType_t xQueueSend(QueueHandle_t handle, const void* item, TickType_t) {
+  Fila* fila = (Fila*)handle;
+  if (fila->quantidade == fila->capacidade) return pdFALSE; // O sketch só envia sem esperar
+  size_t posicao = (fila->inicio + fila->quantidade) % fila->capacidade;
+  memcpy(&fila->itens[posicao * fila->tamanhoItem], item, fila->tamanhoItem);
+  fila->quantidade++;
+  for (Espera* espera : esperas) {       // Acorda uma tarefa que espera esta fila
+    if (!espera->acordada && espera->fila == fila) {
+      acordar(espera);
+      break;
+    }
+  }
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t handle, void* item, TickType_t espera) {
+  Fila* fila = (Fila*)handle;
+  uint64_t prazo = espera == portMAX_DELAY ? UINT64_MAX : agoraMs + espera;
+  while (fila->quantidade == 0) {
+    if (agoraMs >= prazo) return pdFALSE;
+    bloquear(espera == portMAX_DELAY ? portMAX_DELAY : prazo - agoraMs, fila);
+  }
+  memcpy(item, &fila->itens[fila->inicio * fila->tamanhoItem], fila->tamanhoItem);
+  fila->inicio = (fila->inicio + 1) % fila->capacidade;
+  fila->quantidade--;
+  return pdTRUE;
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*funcao)(void*), const char*, uint32_t, void* parametro,
+                                   UBaseType_t, TaskHandle_t*, BaseType_t) {
+  executando++;                          // Conta como executando até bloquear pela primeira vez
+  std::thread([funcao, parametro] {
+    cpu.lock();
+    funcao(parametro);
+  }).detach();
+  return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) { bloquear(ticks, NULL); }
+
+TickType_t xTaskGetTickCount() { return agoraMs; }
+
+uint32_t crc32_le(uint32_t crc, const uint8_t* dados, size_t tamanho) {
+  crc = ~crc;
+  while (tamanho--) {
+    crc ^= *dados++;
+    for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+  }
+  return ~crc;
+}
+
+/*
+ * Periféricos e serviços
+ */
+WiFiClient::WiFiClient(int descritor) : conexao(new Conexao{descritor}) {}
+
+WiFiClient::Conexao::~Conexao() { close(descritor); }
+
+bool WiFiClient::connected() {
+  if (!conexao) return false;
+  char byte;
+  ssize_t lidos = recv(conexao->descritor, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+  return lidos > 0 || (lidos < 0 && errno == EAGAIN); // 0: o cliente fechou a conexão
+}
+
+void DHT::ler() {
+  if (lida && millis() - instante < 2000) return;
+  lida = true;
+  instante = millis();
+  if (!fonteLeituras(pino, millis() / 1000.0, temperatura, umidade) || falha(ruido, std::bernoulli_distribution::param_type(probabilidadeFalhaSensor))) {
+    temperatura = umidade = NAN;
+  }
+}
+
+float DHT::readTemperature() {
+  ler();
+  return temperatura;
+}
+
+float DHT::readHumidity() {
+  ler();
+  return umidade;
+}
+
+bool NTPClient::update() {
+  if (millis() < ntpDisponivelAposMs) return false;
+  sincronizado = true;
+  return true;
+}
+
+unsigned long NTPClient::getEpochTime() const {
+  return (sincronizado ? epochInicial : 0) + deslocamento + millis() / 1000;
+}
+
+bool UniversalTelegramBot::sendMessage(const String&, const String& texto, const String&) {
+  bloquear(latenciaTelegramMs, NULL);    // Conexão TLS e requisição HTTP
+  if (telegramFalhando) return false;
+  mensagensTelegram.push_back(texto.c_str());
+  return true;
+}
+
+/*
+ * LittleFS: cada caminho do sketch é relativo a diretorioFlash
+ */
+struct File::Estado {
+  FILE* arquivo = NULL;
+  DIR* diretorio = NULL;
+  std::string caminho;                  // Caminho no LittleFS
+  std::string nome;                     // Apenas o nome, como no núcleo 2.x
+  ~Estado() {
+    if (arquivo) fclose(arquivo);
+    if (diretorio) closedir(diretorio);
+  }
+};
+
+size_t File::read(uint8_t* destino, size_t tamanho) {
+  if (!estado || !estado->arquivo) return 0;
+  size_t lidos = fread(destino, 1, tamanho, estado->arquivo);
+  bytesLidosFlash += lidos;
+  return lidos;
+}
+
+size_t File::write(const uint8_t* dados, size_t tamanho) {
+  if (!estado || !estado->arquivo) return 0;
+  size_t escritos = fwrite(dados, 1, tamanho, estado->arquivo);
+  bytesGravadosFlash += escritos;
+  return escritos;
+}
+
+bool File::seek(uint32_t posicao) {
+  return estado && estado->arquivo && fseek(estado->arquivo, posicao, SEEK_SET) == 0;
+}
+
+size_t File::size() const {
+  if (!estado || !estado->arquivo) return 0;
+  struct stat informacoes;
+  fflush(estado->arquivo);
+  return fstat(fileno(estado->arquivo), &informacoes) == 0 ? informacoes.st_size : 0;
+}
+
+const char* File::name() const { return estado ? estado->nome.c_str() : ""; }
+
+File File::openNextFile() {
+  if (!estado || !estado->diretorio) return File();
+  while (dirent* entrada = readdir(estado->diretorio)) {
+    if (!strcmp(entrada->d_name, ".") || !strcmp(entrada->d_name, "..")) continue;
+    return LittleFS.open((estado->caminho + "/" + entrada->d_name).c_str(), "r");
+  }
+  return File();
+}
+
+bool LittleFSSimulado::begin(bool) {
+  if (diretorioFlash.empty()) {         // Sem diretório escolhido: partição vazia e temporária
+    char modelo[] = "/tmp/monitoramento-flash-XXXXXX";
+    if (!mkdtemp(modelo)) return false;
+    diretorioFlash = modelo;
+    donoFlashTemporaria = getpid();
+  }
+  std::error_code erro;
+  std::filesystem::create_directories(diretorioFlash, erro);
+  return !erro;
+}
+
+bool LittleFSSimulado::mkdir(const char* caminho) {
+  return ::mkdir(caminhoHost(caminho).c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+bool LittleFSSimulado::exists(const char* caminho) {
+  struct stat informacoes;
+  return stat(caminhoHost(caminho).c_str(), &informacoes) == 0;
+}
+
+bool LittleFSSimulado::remove(const char* caminho) { return ::remove(caminhoHost(caminho).c_str()) == 0; }
+
+bool LittleFSSimulado::rename(const char* origem, const char* destino) {
+  return ::rename(caminhoHost(origem).c_str(), caminhoHost(destino).c_str()) == 0;
+}
+
+File LittleFSSimulado::open(const char* caminho, const char* modo) {
+  File arquivo;
+  std::string host = caminhoHost(caminho);
+  auto estado = std::make_shared<File::Estado>();
+  estado->caminho = caminho;
+  const char* barra = strrchr(caminho, '/');
+  estado->nome = barra ? barra + 1 : caminho;
+  struct stat informacoes;
+  if (modo[0] == 'r' && stat(host.c_str(), &informacoes) == 0 && S_ISDIR(informacoes.st_mode)) {
+    estado->diretorio = opendir(host.c_str());
+    if (!estado->diretorio) return arquivo;
+  } else {
+    const char* modoHost = modo[0] == 'w' ? "wb" : modo[0] == 'a' ? "ab" : "rb";
+    estado->arquivo = fopen(host.c_str(), modoHost);
+    if (!estado->arquivo) return arquivo;
+  }
+  arquivo.estado = estado;
+  return arquivo;
+}
+
+/*
+ * WebServer
+ */
+void WebServer::on(const String& rota, HTTPMethod metodo, THandlerFunction handler) { rotas[{rota.c_str(), metodo}] = handler; }
+
+void WebServer::handleClient() {
+  if (fila.empty()) return;
+  Requisicao atual = std::move(fila.front()); // Uma requisição por chamada, como o WebServer do ESP32
+  fila.pop_front();
+  atender(atual);
+  if (aoResponder) aoResponder(resposta);
+}
+
+const WebServer::Resposta& WebServer::atender(const Requisicao& atual) {
+  resposta.codigo = 0;
+  resposta.tipo.clear();
+  resposta.cabecalhos.clear();
+  resposta.corpo.clear();                // Mantém a capacidade: o corpo não pesa nas alocações medidas
+  resposta.corpo.reserve(1 << 16);
+  resposta.conexao = -1;
+  requisicao = &atual;
+  auto rota = rotas.find({atual.rota, atual.metodo});
+  if (rota == rotas.end()) rota = rotas.find({atual.rota, HTTP_ANY});
+  uint64_t alocacoesAntes = alocacoes, bytesAntes = bytesAlocados;
+  auto inicio = std::chrono::steady_clock::now();
+  if (rota != rotas.end()) rota->second();
+  else send(404, "text/plain", "Not found: " + String(atual.rota));
+  resposta.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+  resposta.alocacoes = alocacoes - alocacoesAntes;
+  resposta.bytesAlocados = bytesAlocados - bytesAntes;
+  if (pontaPar >= 0) {
+    if (conexao.conexao.use_count() > 1) resposta.conexao = pontaPar; // O sketch guardou a conexão
+    else close(pontaPar);
+    pontaPar = -1;
+  }
+  conexao.stop();
+  requisicao = NULL;
+  return resposta;
+}
+
+bool WebServer::hasArg(const String& nome) const {
+  return requisicao && requisicao->argumentos.count(nome.c_str());
+}
+
+String WebServer::arg(const String& nome) const {
+  if (!requisicao) return String();
+  auto argumento = requisicao->argumentos.find(nome.c_str());
+  return argumento == requisicao->argumentos.end() ? String() : String(argumento->second);
+}
+
+String WebServer::header(const String& nome) const {
+  if (!requisicao) return String();
+  auto cabecalho = requisicao->cabecalhos.find(nome.c_str());
+  return cabecalho == requisicao->cabecalhos.end() ? String() : String(cabecalho->second);
+}
+
+void WebServer::sendHeader(const String& nome, const String& valor, bool) {
+  resposta.cabecalhos[nome.c_str()] = valor.c_str();
+}
+
+void WebServer::send(int codigo, const char* tipo, const String& conteudo) {
+  resposta.codigo = codigo;
+  if (tipo) resposta.tipo = tipo;
+  resposta.corpo.append(conteudo.c_str(), conteudo.length());
+}
+
+void WebServer::send_P(int codigo, PGM_P tipo, PGM_P conteudo, size_t tamanho) {
+  resposta.codigo = codigo;
+  resposta.tipo = tipo;
+  resposta.corpo.append(conteudo, tamanho);
+}
+
+void WebServer::sendContent(const char* dados, size_t tamanho) { resposta.corpo.append(dados, tamanho); }
+
+WiFiClient WebServer::client() {
+  if (!conexao.conexao) {
+    int pontas[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, pontas) != 0) return WiFiClient();
+    conexao = WiFiClient(pontas[0]);
+    pontaPar = pontas[1];
+  }
+  return conexao;
+}
+
+/*
+ * Contagem de alocações: substitui o operator new global
+ */
+void* operator new(size_t tamanho) {
+  alocacoes++;
+  bytesAlocados += tamanho;
+  if (void* bloco = malloc(tamanho ? tamanho : 1)) return bloco;
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t tamanho) { return operator new(tamanho); }
+void operator delete(void* bloco) noexcept { free(bloco); }
+void operator delete[](void* bloco) noexcept { free(bloco); }
+void operator delete(void* bloco, size_t) noexcept { free(bloco); }
+void operator delete[](void* bloco, size_t) noexcept { free(bloco); }
@@ -0,0 +1,58 @@
+/*
+ * Simulação no computador: controle do ambiente em que o sketch roda (relógio virtual, sensores,
+ * NTP, Telegram, flash e contagem de alocações). Os programas de Simulação/ incluem este arquivo
+ * e dirigem setup()/loop().
+ *
+ * Relógio virtual: o tempo só avança quando o loop principal bloqueia (delay() ou espera em uma
+ * fila) e todas as tarefas estão bloqueadas; então salta direto para o próximo prazo. Um dia de
+ * operação roda em segundos, e a ordem dos eventos é determinística.
+ */
+#pragma once
+#include <Arduino.h>
+#include <WebServer.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace simulacao {
+
+// Relógio virtual
+uint64_t agoraUs();                       // Tempo virtual desde o início (µs)
+void avancar(unsigned long ms);           // Avança o relógio, executando as tarefas que vencerem
+void encerrar(int codigo);                // Encerra o processo sem esperar as tarefas (bloqueadas)
+
+// Fonte das leituras dos sensores: recebe o pino do DHT e o tempo virtual em segundos; retornar
+// false simula uma leitura inválida (NaN)
+typedef bool (*FonteLeituras)(uint8_t pino, double segundos, float& temperatura, float& umidade);
+bool leituraSintetica(uint8_t pino, double segundos, float& temperatura, float& umidade); // Padrão
+bool carregarTraco(const char* caminho);  // CSV "segundos,temperatura,umidade"; passa a ser a fonte
+extern FonteLeituras fonteLeituras;
+extern double probabilidadeFalhaSensor;   // Fração de leituras inválidas (0 a 1)
+
+// NTP: epoch UTC no instante zero do relógio virtual e quando o servidor passa a responder
+extern uint32_t epochInicial;
+extern unsigned long ntpDisponivelAposMs;
+
+// Telegram
+extern unsigned long latenciaTelegramMs;  // Duração de cada sendMessage() (TLS + HTTP)
+extern bool telegramFalhando;             // sendMessage() retorna false
+extern std::vector<std::string> mensagensTelegram;
+
+// Flash: diretório do host que faz o papel da partição LittleFS
+extern std::string diretorioFlash;
+extern std::atomic<uint64_t> bytesGravadosFlash; // Bytes escritos por File::write()
+extern std::atomic<uint64_t> bytesLidosFlash;    // Bytes lidos por File::read()
+void apagarFlash();
+
+// Requisição a partir de uma URL ("/dados?since=10&formato=bin"), com %XX e + decodificados; em
+// POST, os argumentos fazem o papel dos campos do formulário, que o WebServer junta aos da URL
+WebServer::Requisicao requisicao(const std::string& url, HTTPMethod metodo = HTTP_GET);
+
+// Serial
+extern bool serialSilenciosa;
+
+// Alocações no heap (operator new) desde o início
+extern std::atomic<uint64_t> alocacoes;
+extern std::atomic<uint64_t> bytesAlocados;
+
+}  // namespace simulacao
@@ -0,0 +1,196 @@
+/*
+ * Simulação no computador: executa o sketch sem alterações (setup() e depois loop()) sobre o
+ * relógio virtual, com painéis consultando /dados?since=... a cada 10 s e assinantes de /stream,
+ * e relata a duração real das passagens do loop, as alocações no heap e o tamanho e o custo das
+ * respostas de /dados. Com --flash, o mesmo diretório pode ser reutilizado entre execuções para
+ * simular reinicializações (com --epoch, o relógio continua de onde a execução anterior parou).
+ *
+ * Uso: simulador [--dias N] [--traco leituras.csv] [--flash diretório] [--epoch inicial] [--paineis K]
+ *                [--assinantes K] [--ntp-atraso segundos] [--falhas fração] [--telegram-falhando]
+ *                [--serial] [--rota /caminho?arg=valor]
+ * Com --rota, ao final imprime apenas o corpo da resposta dessa rota (ex.: /metrics).
+ */
+#include <simulacao.h>
+
+#include "Monitoramento.c"
+
+#include <sys/socket.h>
+
+#include <chrono>
+#include <deque>
+#include <vector>
+
+namespace {
+
+// Histograma da duração real das passagens do loop, em décimos de µs até 10 ms
+struct Percentis {
+  std::vector<uint64_t> baldes = std::vector<uint64_t>(100001);
+  uint64_t contagem = 0;
+  double maximo = 0;
+
+  void registrar(double segundos) {
+    double decimos = segundos * 1e7;
+    baldes[decimos < baldes.size() - 1 ? (size_t)decimos : baldes.size() - 1]++;
+    contagem++;
+    if (segundos > maximo) maximo = segundos;
+  }
+
+  double microssegundos(double fracao) const {
+    uint64_t alvo = (uint64_t)(fracao * contagem), acumulado = 0;
+    for (size_t i = 0; i < baldes.size(); i++) {
+      acumulado += baldes[i];
+      if (acumulado > alvo) return i / 10.0;
+    }
+    return maximo * 1e6;
+  }
+};
+
+struct Painel {
+  uint32_t seq = 0;                      // Cursores devolvidos pela última resposta
+  uint32_t seqHoras = 0;
+  unsigned long proximaConsulta;
+};
+
+struct EstatisticaDados {
+  uint64_t respostas = 0;
+  uint64_t bytes = 0;
+  size_t maiorResposta = 0;
+  double segundos = 0;
+  double maisLenta = 0;
+  uint64_t alocacoes = 0;
+};
+
+uint32_t cursor(const std::string& corpo, const char* nome) {
+  size_t posicao = corpo.find(nome);
+  return posicao == std::string::npos ? 0 : strtoul(corpo.c_str() + posicao + strlen(nome), NULL, 10);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  double dias = 1;
+  int quantidadePaineis = 1, quantidadeAssinantes = 0;
+  const char* rota = NULL;
+  simulacao::serialSilenciosa = true;
+  for (int i = 1; i < argc; i++) {
+    std::string opcao = argv[i];
+    const char* valor = i + 1 < argc ? argv[i + 1] : "";
+    if (opcao == "--dias") dias = atof(valor), i++;
+    else if (opcao == "--traco") {
+      if (!simulacao::carregarTraco(valor)) {
+        fprintf(stderr, "Traço vazio ou ilegível: %s\n", valor);
+        return 1;
+      }
+      i++;
+    } else if (opcao == "--flash") simulacao::diretorioFlash = valor, i++;
+    else if (opcao == "--epoch") simulacao::epochInicial = strtoul(valor, NULL, 10), i++;
+    else if (opcao == "--paineis") quantidadePaineis = atoi(valor), i++;
+    else if (opcao == "--assinantes") quantidadeAssinantes = atoi(valor), i++;
+    else if (opcao == "--ntp-atraso") simulacao::ntpDisponivelAposMs = atof(valor) * 1000, i++;
+    else if (opcao == "--falhas") simulacao::probabilidadeFalhaSensor = atof(valor), i++;
+    else if (opcao == "--telegram-falhando") simulacao::telegramFalhando = true;
+    else if (opcao == "--serial") simulacao::serialSilenciosa = false;
+    else if (opcao == "--rota") rota = valor, i++;
+    else {
+      fprintf(stderr, "Opção desconhecida: %s (veja o início de simulador.cpp)\n", argv[i]);
+      return 1;
+    }
+  }
+
+  auto inicioReal = std::chrono::steady_clock::now();
+  setup();
+  uint64_t alocacoesSetup = simulacao::alocacoes;
+
+  std::vector<Painel> paineis(quantidadePaineis);
+  for (int i = 0; i < quantidadePaineis; i++) paineis[i].proximaConsulta = millis() + 10000 * (i + 1) / quantidadePaineis;
+  std::deque<int> consultasPendentes;    // Painel de cada /dados enfileirado, na ordem
+  EstatisticaDados dados;
+  server.aoResponder = [&](const WebServer::Resposta& resposta) {
+    if (consultasPendentes.empty()) return;
+    Painel& painel = paineis[consultasPendentes.front()];
+    consultasPendentes.pop_front();
+    painel.seq = cursor(resposta.corpo, "\"seq\": ");
+    painel.seqHoras = cursor(resposta.corpo, "\"seqHoras\": ");
+    dados.respostas++;
+    dados.bytes += resposta.corpo.size();
+    if (resposta.corpo.size() > dados.maiorResposta) dados.maiorResposta = resposta.corpo.size();
+    dados.segundos += resposta.segundos;
+    if (resposta.segundos > dados.maisLenta) dados.maisLenta = resposta.segundos;
+    dados.alocacoes += resposta.alocacoes;
+  };
+
+  std::vector<int> conexoes;             // Ponta do navegador de cada assinante de /stream
+  for (int i = 0; i < quantidadeAssinantes; i++) {
+    int conexao = server.atender(simulacao::requisicao("/stream")).conexao;
+    if (conexao >= 0) conexoes.push_back(conexao);
+  }
+  uint64_t bytesStream = 0, eventosStream = 0;
+  auto lerAssinantes = [&] {
+    char recebido[4096];
+    for (int conexao : conexoes) {
+      ssize_t lidos;
+      while ((lidos = recv(conexao, recebido, sizeof(recebido), MSG_DONTWAIT)) > 0) {
+        bytesStream += lidos;
+        for (const char* p = recebido; (p = (const char*)memmem(p, recebido + lidos - p, "event: ", 7)); p += 7) eventosStream++;
+      }
+    }
+  };
+
+  Percentis passagens;
+  uint64_t alocacoesLoop = 0;
+  unsigned long fim = millis() + (unsigned long)(dias * 86400000);
+  while (millis() < fim) {
+    for (size_t i = 0; i < paineis.size(); i++) {
+      Painel& painel = paineis[i];
+      if ((long)(millis() - painel.proximaConsulta) < 0) continue;
+      server.enfileirar(simulacao::requisicao("/dados?since=" + std::to_string(painel.seq) +
+                                              "&sinceHoras=" + std::to_string(painel.seqHoras)));
+      consultasPendentes.push_back(i);
+      painel.proximaConsulta += 10000;
+    }
+    uint64_t alocacoesAntes = simulacao::alocacoes;
+    auto inicio = std::chrono::steady_clock::now();
+    loop();
+    passagens.registrar(std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count());
+    alocacoesLoop += simulacao::alocacoes - alocacoesAntes;
+    if (!conexoes.empty() && despertares % 100 == 0) lerAssinantes();
+  }
+  lerAssinantes();
+  double segundosReais = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicioReal).count();
+
+  if (rota) {
+    const std::string& corpo = server.atender(simulacao::requisicao(rota)).corpo;
+    fwrite(corpo.data(), 1, corpo.size(), stdout);
+    simulacao::encerrar(0);
+  }
+
+  printf("Simulação: %.2f dia(s) virtuais em %.1f s reais (%.0fx)\n", dias, segundosReais, dias * 86400 / segundosReais);
+  printf("Leituras: %u registradas, %u falhas do sensor, %u sem relógio, %lu descartadas (fila)\n",
+         (unsigned)historico.total(), (unsigned)canais[CANAL_PRINCIPAL].falhas, (unsigned)leiturasSemRelogio,
+         (unsigned long)leiturasDescartadas);
+  printf("Histórico em RAM: %u leituras, %.2f bits por leitura\n", (unsigned)historico.size(),
+         historico.centesimosDeBitPorAmostra() / 100.0);
+  printf("loop(): %llu passagens; duração real p50 %.1f µs, p99 %.1f µs, p99,9 %.1f µs, máx %.1f µs\n",
+         (unsigned long long)passagens.contagem, passagens.microssegundos(0.5), passagens.microssegundos(0.99),
+         passagens.microssegundos(0.999), passagens.maximo * 1e6);
+  printf("Heap: %llu alocações no setup(); %llu nas passagens do loop (%.3f por passagem)\n",
+         (unsigned long long)alocacoesSetup, (unsigned long long)alocacoesLoop,
+         passagens.contagem ? (double)alocacoesLoop / passagens.contagem : 0.0);
+  if (dados.respostas) {
+    printf("/dados: %llu respostas de %d painel(is); média %.0f bytes, maior %zu bytes; serialização média %.1f µs, "
+           "máx %.1f µs; %.2f alocações por resposta\n",
+           (unsigned long long)dados.respostas, quantidadePaineis, (double)dados.bytes / dados.respostas,
+           dados.maiorResposta, dados.segundos / dados.respostas * 1e6, dados.maisLenta * 1e6,
+           (double)dados.alocacoes / dados.respostas);
+  }
+  if (!conexoes.empty()) {
+    printf("/stream: %zu assinante(s), %llu eventos, %llu bytes recebidos\n", conexoes.size(),
+           (unsigned long long)eventosStream, (unsigned long long)bytesStream);
+  }
+  printf("Flash: %llu bytes de carga útil entregues ao LittleFS (%.1f por leitura)\n", (unsigned long long)simulacao::bytesGravadosFlash.load(),
+         historico.total() ? (double)simulacao::bytesGravadosFlash / historico.total() : 0.0);
+  printf("Telegram: %zu mensagens, %lu alertas enviados, %lu falhos, %lu descartados\n",
+         simulacao::mensagensTelegram.size(), (unsigned long)alertasEnviados, (unsigned long)alertasFalhos,
+         (unsigned long)alertasDescartados);
+  simulacao::encerrar(0);
+}
@@ -0,0 +1,1110 @@
+/*
+ * Simulação no computador: testes das partes do sketch que não dependem do hardware. Cada teste
+ * roda em um processo próprio (testes <nome>, registrado no CTest), pois o sketch guarda o estado
+ * em variáveis globais.
+ */
+#include <simulacao.h>
+
+// Dois canais além do principal (GPIO 16 e 17): todos os testes rodam com as leituras defasadas
+#define CANAIS_ADICIONAIS {"rack2", new SensorDHT(16, DHT22)}, {"rack3", new SensorDHT(17, DHT22)},
+
+#include "Monitoramento.c"
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+int falhas = 0;
+
+#define VERIFICAR(condicao)                                                   \
+  do {                                                                        \
+    if (!(condicao)) {                                                        \
+      printf("%s:%d: falhou: %s\n", __FILE__, __LINE__, #condicao);           \
+      falhas++;                                                               \
+    }                                                                         \
+  } while (0)
+
+#define VERIFICAR_IGUAL(obtido, esperado)                                                          \
+  do {                                                                                             \
+    auto obtidoAvaliado = (obtido);                                                                \
+    auto esperadoAvaliado = (esperado);                                                            \
+    if (!(obtidoAvaliado == esperadoAvaliado)) {                                                   \
+      printf("%s:%d: %s = %s, esperado %s\n", __FILE__, __LINE__, #obtido,                         \
+             texto(obtidoAvaliado).c_str(), texto(esperadoAvaliado).c_str());                      \
+      falhas++;                                                                                    \
+    }                                                                                              \
+  } while (0)
+
+std::string texto(const std::string& valor) { return "\"" + valor + "\""; }
+template <typename T>
+std::string texto(T valor) { return std::to_string(valor); }
+
+// Destino do EscritorJson nos testes: acumula tudo em "saida"
+std::string saida;
+void capturar(const char* dados, size_t tamanho) { saida.append(dados, tamanho); }
+
+Amostra amostra(uint32_t epoch, int32_t temperatura, int32_t umidade) {
+  return {epoch, (int16_t)temperatura, (uint16_t)umidade};
+}
+
+bool iguais(const Amostra& a, const Amostra& b) {
+  return a.epoch == b.epoch && a.temperatura == b.temperatura && a.umidade == b.umidade;
+}
+
+const uint32_t EPOCH = 1750000000;
+
+/*
+ * EscritorJson: mesmo texto que String(valor, casas) (snprintf "%.*f"), em blocos de qualquer tamanho
+ */
+void testeJson() {
+  std::mt19937 gerador(1);
+  std::uniform_real_distribution<float> faixa(-200, 200);
+  std::vector<float> valores = {0.0f, -0.0f, 0.125f, 0.375f, -2.5f, 24.5f, 24.005f, 99.995f, 1e-7f, 4e9f, -5e9f, NAN, INFINITY, -INFINITY};
+  for (int i = 0; i < 20000; i++) valores.push_back(faixa(gerador));
+  for (float valor : valores) {
+    for (unsigned int casas = 0; casas <= 3; casas++) {
+      EscritorJson json;
+      json.saida = capturar;
+      saida.clear();
+      json.escreverFixo(valor, casas);
+      json.descarregar();
+      VERIFICAR_IGUAL(saida, std::string(String(valor, casas).c_str()));
+    }
+  }
+
+  for (int32_t centesimos = -4000; centesimos <= 10000; centesimos++) {
+    EscritorJson json;
+    json.saida = capturar;
+    saida.clear();
+    json.escreverCentesimos(centesimos, 2);
+    json.descarregar();
+    char esperado[16];
+    snprintf(esperado, sizeof(esperado), "%.2f", centesimos / 100.0);
+    VERIFICAR_IGUAL(saida, std::string(esperado));
+  }
+  const std::pair<int32_t, const char*> umaCasa[] = {{2450, "24.5"}, {2455, "24.6"}, {-2455, "-24.6"}, {4, "0.0"}, {-5, "-0.1"}};
+  for (const auto& caso : umaCasa) {
+    EscritorJson json;
+    json.saida = capturar;
+    saida.clear();
+    json.escreverCentesimos(caso.first, 1);
+    json.descarregar();
+    VERIFICAR_IGUAL(saida, std::string(caso.second));
+  }
+
+  // Textos maiores que o buffer atravessam blocos sem perder nem repetir bytes
+  EscritorJson json;
+  json.saida = capturar;
+  saida.clear();
+  std::string esperado;
+  for (unsigned long i = 0; i < 5000; i++) {
+    json.escreverInteiro(i * 7919);
+    json.escrever(",");
+    esperado += std::to_string(i * 7919) + ",";
+  }
+  json.descarregar();
+  VERIFICAR_IGUAL(saida, esperado);
+}
+
+/*
+ * RingBuffer: ordem, sobrescrita do mais antigo e iteradores
+ */
+void testeRingBuffer() {
+  RingBuffer<int, 8> buffer;
+  VERIFICAR(buffer.empty());
+  VERIFICAR(buffer.begin() == buffer.end());
+  for (int i = 0; i < 5; i++) buffer.push(i);
+  VERIFICAR_IGUAL(buffer.size(), 5u);
+  VERIFICAR_IGUAL(buffer[0], 0);
+  for (int i = 5; i < 20; i++) buffer.push(i);
+  VERIFICAR_IGUAL(buffer.size(), 8u);
+  VERIFICAR_IGUAL(buffer.total(), 20u);
+  VERIFICAR_IGUAL(buffer[0], 12);
+  VERIFICAR_IGUAL(buffer.back(), 19);
+  int esperado = 12;
+  for (int valor : buffer) VERIFICAR_IGUAL(valor, esperado++);
+  VERIFICAR_IGUAL(esperado, 20);
+  auto it = buffer.ultimos(3);
+  VERIFICAR_IGUAL(*it, 17);
+  VERIFICAR(it + 3 == buffer.end());
+  VERIFICAR(buffer.ultimos(100) == buffer.begin());
+
+  // Mais de duas voltas no buffer
+  RingBuffer<uint32_t, 4> longo;
+  for (uint32_t i = 0; i < 10; i++) longo.push(i);
+  VERIFICAR_IGUAL(longo[3], 9u);
+
+  // Amostra empacotada: 8 bytes por leitura, contra os vetores paralelos de float e String
+  VERIFICAR_IGUAL(sizeof(Amostra), 8u);
+}
+
+/*
+ * SerieComprimida: tudo o que sai é igual ao que entrou (a parte que ainda cabe na arena)
+ */
+void testeSerie() {
+  static SerieComprimida<8192, 64> serie;
+  std::deque<Amostra> referencia;
+  std::mt19937 gerador(2);
+  uint32_t epoch = EPOCH;
+  int32_t temperatura = 2450, umidade = 5500;
+  for (int i = 0; i < 40000; i++) {
+    int trecho = i / 2000 % 4;           // Alterna padrões: décimos, centésimos, lacunas e saltos
+    if (trecho == 0) {
+      epoch += 10;
+      temperatura += (int)(gerador() % 3) * 10 - 10;
+      umidade += (int)(gerador() % 5) * 10 - 20;
+    } else if (trecho == 1) {
+      epoch += 10 + gerador() % 2;
+      temperatura += (int)(gerador() % 41) - 20;
+      umidade += (int)(gerador() % 81) - 40;
+    } else if (trecho == 2) {
+      epoch += gerador() % 50 == 0 ? 3600 + gerador() % 100000 : 10;
+      temperatura += (int)(gerador() % 3) - 1;
+    } else {
+      epoch += 10;
+      temperatura = (int)(gerador() % 14001) - 4000; // -40,00 a 100,00
+      umidade = gerador() % 10001;
+    }
+    temperatura = std::max(-4000, std::min(10000, temperatura));
+    umidade = std::max(0, std::min(10000, umidade));
+    serie.push(amostra(epoch, temperatura, umidade));
+    referencia.push_back(amostra(epoch, temperatura, umidade));
+
+    if (i % 997 != 0 && i != 39999) continue;
+    VERIFICAR_IGUAL(serie.total(), (uint32_t)referencia.size());
+    VERIFICAR(serie.size() <= referencia.size());
+    VERIFICAR(iguais(serie.back(), referencia.back()));
+    size_t indice = referencia.size() - serie.size();
+    for (auto it = serie.begin(); it != serie.end(); ++it, ++indice) {
+      if (!iguais(*it, referencia[indice])) {
+        VERIFICAR(!"amostra decodificada difere da gravada");
+        break;
+      }
+    }
+    auto ultimas = serie.ultimos(10);
+    VERIFICAR(iguais(*ultimas, referencia[referencia.size() - std::min<size_t>(10, serie.size())]));
+  }
+  VERIFICAR(serie.size() < serie.total()); // A arena encheu e descartou blocos antigos
+
+  // primeiraComEpoch: primeira amostra guardada com instante >= epoch, ou total()
+  uint32_t primeira = serie.total() - serie.size();
+  for (int i = 0; i < 2000; i++) {
+    uint32_t procurado = referencia[primeira].epoch - 100 + gerador() % (epoch - referencia[primeira].epoch + 200);
+    uint32_t esperado = primeira;
+    while (esperado < referencia.size() && referencia[esperado].epoch < procurado) esperado++;
+    VERIFICAR_IGUAL(serie.primeiraComEpoch(procurado), esperado);
+  }
+
+  // bitsEstimados acompanha o tamanho real dos blocos selados (usado na recuperação da flash)
+  static SerieComprimida<65536, 128> semDescarte;
+  uint32_t estimados = 0;
+  for (size_t inicio = 0; inicio + 128 <= 64 * 128; inicio += 128) {
+    Amostra bloco[128];
+    for (size_t i = 0; i < 128; i++) {
+      bloco[i] = referencia[inicio + i];
+      semDescarte.push(bloco[i]);
+    }
+    estimados += semDescarte.bitsEstimados(bloco, 128);
+  }
+  VERIFICAR(estimados > semDescarte.bitsSelados() * 0.95 && estimados < semDescarte.bitsSelados() * 1.05);
+}
+
+/*
+ * Níveis de agregação: a cascata (Welford/Chan) bate com o cálculo direto sobre as leituras, e
+ * /resumo usa o nível mais fino que ainda guarda o início da janela
+ */
+struct Direto {
+  uint32_t n = 0;
+  int32_t minimo = INT32_MAX, maximo = INT32_MIN;
+  double soma = 0, somaQuadrados = 0;
+  void somar(int32_t valor) {
+    n++;
+    minimo = std::min(minimo, valor);
+    maximo = std::max(maximo, valor);
+    soma += valor;
+    somaQuadrados += (double)valor * valor;
+  }
+  double media() const { return soma / n; }
+  double variancia() const { return somaQuadrados / n - media() * media(); }
+};
+
+void verificarEstatistica(const Estatistica& estatistica, const Direto& direto) {
+  VERIFICAR_IGUAL(estatistica.n, direto.n);
+  VERIFICAR_IGUAL((int32_t)estatistica.minimo, direto.minimo);
+  VERIFICAR_IGUAL((int32_t)estatistica.maximo, direto.maximo);
+  VERIFICAR(fabs(estatistica.media - direto.media()) < 0.05);
+  VERIFICAR(fabs(estatistica.variancia() - direto.variancia()) < 0.01 * std::max(1.0, direto.variancia()));
+}
+
+// Resume a janela e confere o nível, o início efetivo e a contagem (uma leitura a cada 10 s)
+void verificarResumo(uint32_t agora, uint32_t segundos, const char* nivelEsperado) {
+  Agregado total;
+  uint32_t resolucao;
+  VERIFICAR_IGUAL(std::string(resumirJanela(agora, segundos, total, resolucao)), std::string(nivelEsperado));
+  VERIFICAR(total.epoch >= agora - segundos && total.epoch < agora - segundos + resolucao);
+  VERIFICAR_IGUAL(total.temperatura.n, (agora - total.epoch) / 10 + 1);
+}
+
+void testeAgregacao() {
+  std::mt19937 gerador(3);
+  std::map<uint32_t, Direto> horasTemperatura, horasUmidade, diasTemperatura;
+  const uint32_t dias = 25;
+  const uint32_t inicio = EPOCH - EPOCH % 86400;
+  for (uint32_t epoch = inicio; epoch < inicio + dias * 86400; epoch += 10) {
+    Amostra leitura = amostra(epoch, 2000 + gerador() % 1000, 4000 + gerador() % 3000);
+    Agregado hora, dia;
+    agregarAmostra(leitura, hora, dia);
+    horasTemperatura[epoch - epoch % 3600].somar(leitura.temperatura);
+    horasUmidade[epoch - epoch % 3600].somar(leitura.umidade);
+    diasTemperatura[epoch - epoch % 86400].somar(leitura.temperatura);
+  }
+  // Janelas fechadas: as que cabem em cada nível, fora a em andamento
+  VERIFICAR_IGUAL(nivelMinuto.fechados.size(), nivelMinuto.fechados.capacity());
+  VERIFICAR_IGUAL(nivelHora.fechados.size(), nivelHora.fechados.capacity());
+  VERIFICAR_IGUAL(nivelDia.fechados.size(), diasTemperatura.size() - 1);
+  for (const Agregado& hora : nivelHora.fechados) {
+    verificarEstatistica(hora.temperatura, horasTemperatura[hora.epoch]);
+    verificarEstatistica(hora.umidade, horasUmidade[hora.epoch]);
+  }
+  for (const Agregado& dia : nivelDia.fechados) verificarEstatistica(dia.temperatura, diasTemperatura[dia.epoch]);
+
+  // O minuto guarda ~2,1 horas e a hora ~10,7 dias: janelas maiores passam ao nível seguinte
+  uint32_t agora = inicio + dias * 86400 - 10;
+  verificarResumo(agora, 3600, "minuto");
+  verificarResumo(agora, 2 * 3600, "minuto");
+  verificarResumo(agora, 2 * 3600 + 1800, "hora");
+  verificarResumo(agora, 12 * 3600, "hora");
+  verificarResumo(agora, 20 * 3600, "hora");
+  verificarResumo(agora, 2 * 86400, "hora");
+  verificarResumo(agora, 10 * 86400, "hora");
+  verificarResumo(agora, 11 * 86400, "dia");
+  verificarResumo(agora, 15 * 86400, "dia");
+  verificarResumo(agora, 20 * 86400, "dia");
+
+  // Janela maior que todo o período: começa na primeira leitura
+  Agregado total;
+  uint32_t resolucao;
+  VERIFICAR_IGUAL(std::string(resumirJanela(agora, 60 * 86400, total, resolucao)), std::string("dia"));
+  VERIFICAR_IGUAL(total.epoch, inicio);
+  VERIFICAR_IGUAL(total.temperatura.n, dias * 8640);
+}
+
+/*
+ * Regras de alerta: histerese, duração mínima e taxa de variação
+ */
+std::vector<Alerta> avaliar(int indiceCanal, const Amostra& leitura) {
+  canais[indiceCanal].registrar(leitura);
+  avaliarRegras(indiceCanal, leitura);
+  std::vector<Alerta> alertas;
+  Alerta alerta;
+  while (xQueueReceive(filaAlertas, &alerta, 0) == pdTRUE) alertas.push_back(alerta);
+  return alertas;
+}
+
+void testeRegras() {
+  filaAlertas = xQueueCreate(TAMANHO_FILA_ALERTAS, sizeof(Alerta));
+  numRegras = 1;
+
+  // Limite com histerese: dispara acima de 24,50 e só normaliza abaixo de 24,00
+  regras[0] = {"Alta", 0, METRICA_TEMPERATURA, REGRA_LIMITE, 1, 2450, 50, 0, 0, true};
+  const int32_t valores[] = {2400, 2460, 2440, 2470, 2410, 2399, 2460};
+  const int esperados[] = {0, 1, 0, 0, 0, 1, 1}; // Alertas em cada leitura
+  uint32_t epoch = EPOCH;
+  std::vector<bool> normalizacoes;
+  for (size_t i = 0; i < sizeof(valores) / sizeof(valores[0]); i++) {
+    std::vector<Alerta> alertas = avaliar(0, amostra(epoch += 10, valores[i], 5000));
+    VERIFICAR_IGUAL(alertas.size(), (size_t)esperados[i]);
+    for (const Alerta& alerta : alertas) normalizacoes.push_back(alerta.normalizou);
+  }
+  VERIFICAR(normalizacoes == std::vector<bool>({false, true, false}));
+  VERIFICAR_IGUAL(estadosRegras[0].disparos, 2u);
+
+  // Duração: a condição precisa valer por 300 s; uma interrupção recomeça a contagem
+  regras[0] = {"Umida", 0, METRICA_UMIDADE, REGRA_LIMITE, 1, 7000, 500, 0, 300, true};
+  estadosRegras[0] = EstadoRegra();
+  int disparoEm = -1;
+  for (int i = 0; i < 80; i++) {
+    int32_t umidade = i == 20 ? 6900 : 7100;
+    if (!avaliar(0, amostra(epoch += 10, 2300, umidade)).empty() && disparoEm < 0) disparoEm = i;
+  }
+  VERIFICAR_IGUAL(disparoEm, 21 + 30); // 300 s depois da leitura seguinte à interrupção
+
+  // Taxa: +0,30 °C/min medida em 600 s, só depois de o histórico cobrir a janela
+  regras[0] = {"Subida", 0, METRICA_TEMPERATURA, REGRA_TAXA, 1, 20, 10, 600, 0, true};
+  estadosRegras[0] = EstadoRegra();
+  canais[0].historico = RingBuffer<Amostra, capacidadeCanal>();
+  int alertasTaxa = 0;
+  disparoEm = -1;
+  for (int i = 0; i < 100; i++) {
+    std::vector<Alerta> alertas = avaliar(0, amostra(epoch += 10, 2000 + 5 * i, 5000));
+    if (!alertas.empty() && disparoEm < 0) {
+      disparoEm = i;
+      VERIFICAR_IGUAL(alertas[0].valor, 30);
+    }
+    alertasTaxa += alertas.size();
+  }
+  VERIFICAR_IGUAL(disparoEm, 60);
+  VERIFICAR_IGUAL(alertasTaxa, 1);
+
+  // Regras inativas ou de outro canal não são avaliadas
+  regras[0].ativa = false;
+  estadosRegras[0] = EstadoRegra();
+  for (int i = 0; i < 100; i++) VERIFICAR(avaliar(0, amostra(epoch += 10, 3000 + 50 * i, 5000)).empty());
+}
+
+/*
+ * /regras: alterações só por POST; nomes de regra inválidos são rejeitados e, ao carregar da
+ * flash, substituídos
+ */
+void testeNomes() {
+  VERIFICAR(nomeRegraValido("Temperatura alta"));
+  VERIFICAR(nomeRegraValido("Umidade > 70% (sala)"));
+  VERIFICAR(!nomeRegraValido("Aspas \" no meio"));
+  VERIFICAR(!nomeRegraValido("Barra \\ invertida"));
+  VERIFICAR(!nomeRegraValido("Quebra\nde linha"));
+
+  simulacao::serialSilenciosa = true;
+  setup();
+  const int iniciais = numRegras;
+  const WebServer::Resposta& consulta = server.atender(simulacao::requisicao("/regras"));
+  VERIFICAR_IGUAL(consulta.codigo, 200);
+  VERIFICAR(consulta.corpo.find("\"nome\": \"Temperatura alta\"") != std::string::npos);
+  const WebServer::Resposta& porGet = server.atender(simulacao::requisicao("/regras?id=0&nome=Forno"));
+  VERIFICAR_IGUAL(porGet.codigo, 405);
+  VERIFICAR_IGUAL(server.atender(simulacao::requisicao("/regras?remover=0")).codigo, 405);
+  VERIFICAR_IGUAL(numRegras, iniciais);
+  VERIFICAR_IGUAL(std::string(regras[0].nome), std::string("Temperatura alta"));
+  VERIFICAR_IGUAL(server.atender(simulacao::requisicao("/regras", HTTP_POST)).codigo, 400);
+
+  const WebServer::Resposta& recusada = server.atender(simulacao::requisicao("/regras?id=0&nome=Forno%22quente", HTTP_POST));
+  VERIFICAR_IGUAL(recusada.codigo, 400);
+  VERIFICAR_IGUAL(std::string(regras[0].nome), std::string("Temperatura alta"));
+  const WebServer::Resposta& aceita = server.atender(simulacao::requisicao("/regras?id=0&nome=Forno+quente", HTTP_POST));
+  VERIFICAR_IGUAL(aceita.codigo, 200);
+  VERIFICAR(aceita.corpo.find("\"nome\": \"Forno quente\"") != std::string::npos);
+  std::string nova = "/regras?id=" + std::to_string(iniciais) + "&nome=Outra";
+  VERIFICAR_IGUAL(server.atender(simulacao::requisicao(nova, HTTP_POST)).codigo, 200);
+  VERIFICAR_IGUAL(numRegras, iniciais + 1);
+  std::string remocao = "/regras?remover=" + std::to_string(iniciais);
+  VERIFICAR_IGUAL(server.atender(simulacao::requisicao(remocao, HTTP_POST)).codigo, 200);
+  VERIFICAR_IGUAL(numRegras, iniciais);
+
+  // Arquivo gravado por uma versão sem validação: o nome inválido vira "Regra"
+  RegistroRegra registro = {regras[0], 0};
+  strcpy(registro.regra.nome, "Com \"aspas\"");
+  registro.crc = calcularCrc(&registro.regra, sizeof(registro.regra));
+  File arquivo = LittleFS.open(ARQUIVO_REGRAS, "w");
+  arquivo.write((const uint8_t*)&registro, sizeof(registro));
+  arquivo.close();
+  carregarRegras();
+  VERIFICAR_IGUAL(numRegras, 1);
+  VERIFICAR_IGUAL(std::string(regras[0].nome), std::string("Regra"));
+}
+
+/*
+ * /dados: o JSON em fluxo é igual ao montado com String (formato original) e o binário traz os
+ * mesmos registros
+ */
+void testeDados() {
+  uint32_t epoch = EPOCH;
+  for (int i = 0; i < 2000; i++) {
+    epoch += 10;
+    registrarAmostra(amostra(epoch, 2000 + (i * 37) % 900 / 10 * 10, 4000 + (i * 53) % 3000 / 10 * 10), false);
+  }
+
+  String esperado = "{ \"temperaturas\": [";
+  for (size_t i = historico.size() - maxLeituras; i < historico.size(); i++) {
+    auto it = historico.iterador(historico.total() - historico.size() + i);
+    esperado += String(it->temperatura / 100.0f, 2) + (i + 1 < historico.size() ? "," : "");
+  }
+  esperado += "], \"umidades\": [";
+  for (size_t i = historico.size() - maxLeituras; i < historico.size(); i++) {
+    auto it = historico.iterador(historico.total() - historico.size() + i);
+    esperado += String(it->umidade / 100.0f, 2) + (i + 1 < historico.size() ? "," : "");
+  }
+  esperado += "], \"mediasTempHoras\": [";
+  size_t horas = nivelMinuto.fechados.size();
+  for (size_t i = horas - maxHoras; i < horas; i++) {
+    esperado += String(lroundf(nivelMinuto.fechados[i].temperatura.media) / 100.0f, 2) + (i + 1 < horas ? "," : "");
+  }
+  esperado += "], \"mediasUmidHoras\": [";
+  for (size_t i = horas - maxHoras; i < horas; i++) {
+    esperado += String(lroundf(nivelMinuto.fechados[i].umidade.media) / 100.0f, 2) + (i + 1 < horas ? "," : "");
+  }
+  esperado += "], \"horas\": [";
+  for (size_t i = horas - maxHoras; i < horas; i++) {
+    char quando[17];
+    formatarEpoch(nivelMinuto.fechados[i].epoch, quando, sizeof(quando));
+    esperado += String("\"") + (quando + 11) + "\"" + (i + 1 < horas ? "," : "");
+  }
+  esperado += "], \"logs\": [";
+  for (size_t i = historico.size() - maxLog; i < historico.size(); i++) {
+    auto it = historico.iterador(historico.total() - historico.size() + i);
+    char quando[17];
+    formatarEpoch(it->epoch, quando, sizeof(quando));
+    esperado += String("\"") + quando + " Temperatura " + String(it->temperatura / 100.0f, 1) + "°C / Umidade " +
+                String(it->umidade / 100.0f, 1) + "%\"" + (i + 1 < historico.size() ? "," : "");
+  }
+  esperado += "] }";
+
+  server.on("/dados", handleDados);
+  VERIFICAR_IGUAL(server.atender(simulacao::requisicao("/dados")).corpo, std::string(esperado.c_str()));
+
+  // Incremental: apenas o que veio depois dos cursores
+  std::string corpo = server.atender(simulacao::requisicao("/dados?since=" + std::to_string(historico.total() - 3) +
+                                                           "&sinceHoras=" + std::to_string(nivelMinuto.fechados.total()))).corpo;
+  VERIFICAR(corpo.find("\"seq\": " + std::to_string(historico.total())) != std::string::npos);
+  VERIFICAR(corpo.find("\"mediasTempHoras\": []") != std::string::npos);
+  size_t temperaturas = corpo.find("\"temperaturas\": [");
+  VERIFICAR_IGUAL(std::count(corpo.begin() + temperaturas, corpo.begin() + corpo.find(']', temperaturas), ','), 2);
+
+  // Binário: cabeçalho e as mesmas leituras
+  const WebServer::Resposta& binario = server.atender(simulacao::requisicao("/dados?formato=bin"));
+  VERIFICAR_IGUAL(binario.corpo.size(), sizeof(CabecalhoDadosBinario) + (maxLeituras + maxHoras) * sizeof(Amostra));
+  CabecalhoDadosBinario cabecalho;
+  memcpy(&cabecalho, binario.corpo.data(), sizeof(cabecalho));
+  VERIFICAR_IGUAL(cabecalho.seq, historico.total());
+  Amostra ultima;
+  memcpy(&ultima, binario.corpo.data() + sizeof(cabecalho) + (maxLeituras - 1) * sizeof(Amostra), sizeof(ultima));
+  VERIFICAR(iguais(ultima, historico.back()));
+  VERIFICAR_IGUAL(binario.alocacoes, 0u);
+}
+
+/*
+ * Flash: segmentos por acréscimo, retenção e custo de escrita por leitura
+ */
+int contarSegmentos() {
+  int segmentos = 0;
+  File diretorio = LittleFS.open(DIRETORIO_HISTORICO);
+  for (File arquivo = diretorio.openNextFile(); arquivo; arquivo = diretorio.openNextFile()) {
+    if (strstr(arquivo.name(), ".seg")) segmentos++;
+  }
+  return segmentos;
+}
+
+void testeFlash() {
+  simulacao::serialSilenciosa = true;
+  recuperarHistorico();
+  VERIFICAR(armazenamentoAtivo);
+  uint64_t antes = simulacao::bytesGravadosFlash;
+  const uint32_t leituras = (MAX_SEGMENTOS + 3) * BLOCOS_POR_SEGMENTO * AMOSTRAS_POR_BLOCO + 5;
+  uint32_t epoch = EPOCH;
+  for (uint32_t i = 0; i < leituras; i++) registrarAmostra(amostra(epoch += 10, 2000 + i % 500, 5000), true);
+  // Blocos de 264 bytes a cada 32 leituras (8,25 bytes por leitura) mais as janelas de hora e dia
+  double porLeitura = (double)(simulacao::bytesGravadosFlash - antes) / leituras;
+  VERIFICAR(porLeitura > sizeof(BlocoHistorico) / (double)AMOSTRAS_POR_BLOCO && porLeitura < 8.5);
+
+  VERIFICAR_IGUAL(contarSegmentos(), (int)MAX_SEGMENTOS);
+  VERIFICAR_IGUAL(segmentoAtual - primeiroSegmento + 1, MAX_SEGMENTOS);
+  VERIFICAR_IGUAL(amostrasPendentes, 5);
+}
+
+/*
+ * Reinicialização: o histórico recuperado é o gravado (sem as leituras ainda pendentes), o último
+ * segmento é continuado, um bloco cortado no fim não impede a recuperação e o limite de segmentos
+ * vale já na inicialização
+ */
+std::vector<Amostra> gravadas;          // Calculadas pelo processo principal, gravadas por um filho
+
+// Executa "funcao" em um processo filho, que começa com as variáveis globais do sketch intactas
+bool emProcessoNovo(void (*funcao)()) {
+  fflush(stdout);
+  pid_t filho = fork();
+  if (filho == 0) {
+    funcao();
+    simulacao::encerrar(falhas ? 1 : 0);
+  }
+  int estado;
+  waitpid(filho, &estado, 0);
+  return WIFEXITED(estado) && WEXITSTATUS(estado) == 0;
+}
+
+void verificarRecuperado() {
+  recuperarHistorico();
+  size_t gravadasNaFlash = gravadas.size() / AMOSTRAS_POR_BLOCO * AMOSTRAS_POR_BLOCO;
+  VERIFICAR(historico.total() > 0);
+  VERIFICAR(historico.total() <= gravadasNaFlash);
+  VERIFICAR(iguais(historico.back(), gravadas[gravadasNaFlash - 1]));
+  size_t indice = gravadasNaFlash - historico.size();
+  for (auto it = historico.begin(); it != historico.end(); ++it, ++indice) {
+    if (!iguais(*it, gravadas[indice])) {
+      VERIFICAR(!"leitura recuperada difere da gravada");
+      break;
+    }
+  }
+  VERIFICAR(historico.size() == historico.total()); // Reaplicou apenas o que cabe na arena
+  VERIFICAR(historico.bitsSelados() > historico.bitsUteis() * 0.8);
+  VERIFICAR(simulacao::bytesLidosFlash < gravadasNaFlash * sizeof(Amostra) / 2); // Sem ler tudo
+  uint32_t horas = gravadas.back().epoch / 3600 - gravadas.front().epoch / 3600 + 1;
+  VERIFICAR_IGUAL(nivelHora.fechados.size(), (size_t)horas - 1); // Gravadas quando fecharam
+}
+
+void testeReinicio() {
+  simulacao::serialSilenciosa = true;
+  LittleFS.begin(true);                 // Cria a partição temporária antes dos processos filhos
+  uint32_t epoch = EPOCH;
+  std::mt19937 gerador(4);
+  for (int i = 0; i < 8 * 8640; i++) {  // Mais do que a arena comporta
+    gravadas.push_back(amostra(epoch += 10, 2000 + gerador() % 40 * 10, 5000 + gerador() % 20 * 10));
+  }
+  VERIFICAR(emProcessoNovo([] {
+    recuperarHistorico();
+    for (const Amostra& leitura : gravadas) registrarAmostra(leitura, true);
+  }));
+  VERIFICAR(emProcessoNovo([] {
+    verificarRecuperado();
+    VERIFICAR(blocosNoSegmento > 0);    // Continua o último segmento, parcial
+  }));
+
+  // Reinicializações frequentes não criam um segmento por execução
+  int segmentos = contarSegmentos();
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < AMOSTRAS_POR_BLOCO; j++) { // Um bloco a mais por execução
+      Amostra leitura = gravadas.back();
+      leitura.epoch += 10;
+      gravadas.push_back(leitura);
+    }
+    VERIFICAR(emProcessoNovo([] {
+      recuperarHistorico();
+      for (size_t j = gravadas.size() - AMOSTRAS_POR_BLOCO; j < gravadas.size(); j++) registrarAmostra(gravadas[j], true);
+    }));
+  }
+  VERIFICAR(contarSegmentos() <= segmentos + 1);
+
+  // Bloco cortado por queda de energia no fim do último segmento
+  VERIFICAR(emProcessoNovo([] {
+    recuperarHistorico();
+    char caminho[32];
+    caminhoSegmento(segmentoAtual, caminho, sizeof(caminho));
+    File arquivo = LittleFS.open(caminho, "a");
+    arquivo.write((const uint8_t*)"cortado", 7);
+  }));
+  VERIFICAR(emProcessoNovo([] {
+    verificarRecuperado();
+    VERIFICAR_IGUAL(blocosNoSegmento, 0u); // Novas gravações em um segmento novo
+  }));
+
+  // Segmentos além de MAX_SEGMENTOS (ex.: deixados por uma versão anterior) são apagados ao iniciar
+  VERIFICAR(emProcessoNovo([] {
+    recuperarHistorico();
+    for (uint32_t numero = segmentoAtual; numero < segmentoAtual + 20; numero++) {
+      char caminho[32];
+      caminhoSegmento(numero, caminho, sizeof(caminho));
+      LittleFS.open(caminho, "w");      // Segmentos vazios, sem blocos
+    }
+  }));
+  VERIFICAR(emProcessoNovo([] {
+    recuperarHistorico();
+    VERIFICAR_IGUAL(contarSegmentos(), (int)MAX_SEGMENTOS);
+    VERIFICAR_IGUAL(segmentoAtual - primeiroSegmento + 1, MAX_SEGMENTOS);
+  }));
+}
+
+/*
+ * /export: csv, ndjson e bin trazem exatamente as leituras de [from, to], em ordem, inclusive
+ * quando o intervalo passa da flash para o lote ainda não gravado, que está só na RAM
+ */
+std::string exportar(uint32_t de, uint32_t ate, const char* formato) {
+  std::string url = "/export?from=" + std::to_string(de) + "&to=" + std::to_string(ate) + "&format=" + formato;
+  int conexao = server.atender(simulacao::requisicao(url)).conexao;
+  if (conexao < 0) return "";
+  std::string recebido;
+  char parte[4096];
+  for (;;) {
+    atenderExportacao();               // Uma fatia por passagem do loop
+    ssize_t lidos;
+    while ((lidos = recv(conexao, parte, sizeof(parte), MSG_DONTWAIT)) > 0) recebido.append(parte, lidos);
+    if (lidos == 0) break;             // O sketch fechou a conexão: fim dos dados
+  }
+  close(conexao);
+  size_t cabecalhos = recebido.find("\r\n\r\n");
+  return cabecalhos == std::string::npos ? "" : recebido.substr(cabecalhos + 4);
+}
+
+std::string esperadoExportacao(const std::vector<Amostra>& leituras, uint32_t de, uint32_t ate, const char* formato) {
+  std::string resultado = strcmp(formato, "csv") == 0 ? "epoch,temperatura,umidade\n" : "";
+  for (const Amostra& leitura : leituras) {
+    if (leitura.epoch < de || leitura.epoch > ate) continue;
+    char linha[96];
+    if (strcmp(formato, "bin") == 0) {
+      resultado.append((const char*)&leitura, sizeof(leitura));
+      continue;
+    }
+    const char* modelo = strcmp(formato, "csv") == 0 ? "%u,%d.%02d,%d.%02d\n"
+                                                     : "{\"epoch\":%u,\"temperatura\":%d.%02d,\"umidade\":%d.%02d}\n";
+    snprintf(linha, sizeof(linha), modelo, (unsigned)leitura.epoch, leitura.temperatura / 100, leitura.temperatura % 100,
+             leitura.umidade / 100, leitura.umidade % 100);
+    resultado += linha;
+  }
+  return resultado;
+}
+
+void testeExportacao() {
+  simulacao::serialSilenciosa = true;
+  setup();
+  VERIFICAR(armazenamentoAtivo);
+  std::vector<Amostra> leituras;
+  uint32_t epoch = EPOCH;
+  for (uint32_t i = 0; i < 3 * BLOCOS_POR_SEGMENTO * AMOSTRAS_POR_BLOCO + 7; i++) { // 3 segmentos e 7 pendentes
+    leituras.push_back(amostra(epoch += 10, 2000 + i % 700, 4000 + i * 7 % 3000));
+    registrarAmostra(leituras.back(), true);
+  }
+  VERIFICAR_IGUAL(amostrasPendentes, 7);
+  const size_t naFlash = leituras.size() - 7;
+  const uint32_t ultimaNaFlash = leituras[naFlash - 1].epoch;
+  const uint32_t segundoSegmento = leituras[BLOCOS_POR_SEGMENTO * AMOSTRAS_POR_BLOCO].epoch;
+
+  struct Intervalo {
+    uint32_t de, ate;
+  };
+  const Intervalo intervalos[] = {
+      {0, UINT32_MAX},                                       // Tudo
+      {leituras[100].epoch + 5, leituras[1000].epoch},       // Início entre duas leituras
+      {segundoSegmento - 10, segundoSegmento + 10},          // Fronteira entre segmentos
+      {ultimaNaFlash - 40, leituras.back().epoch - 20},      // Da flash para a RAM
+      {ultimaNaFlash - 40, ultimaNaFlash},                   // Termina na última leitura gravada
+      {ultimaNaFlash, ultimaNaFlash + 10},                   // Última gravada e a primeira pendente
+      {ultimaNaFlash + 20, UINT32_MAX},                      // Só o lote pendente
+      {leituras.back().epoch + 1, UINT32_MAX},               // Nada
+  };
+  for (const char* formato : {"csv", "ndjson", "bin"}) {
+    for (const Intervalo& intervalo : intervalos) {
+      std::string corpo = exportar(intervalo.de, intervalo.ate, formato);
+      std::string esperado = esperadoExportacao(leituras, intervalo.de, intervalo.ate, formato);
+      VERIFICAR_IGUAL(corpo.size(), esperado.size());
+      VERIFICAR(corpo == esperado);
+      VERIFICAR(!exportacao.ativa);
+    }
+  }
+
+  VERIFICAR_IGUAL(server.atender(simulacao::requisicao("/export?format=xml")).codigo, 400);
+  VERIFICAR_IGUAL(server.atender(simulacao::requisicao("/export?from=20&to=10")).codigo, 400);
+}
+
+/*
+ * /stream: cada leitura vira um evento SSE completo "amostra" com exatamente as leituras novas; o
+ * evento do pior caso cabe em TAMANHO_EVENTO; um assinante que não lê é desconectado sem atrasar
+ * os demais
+ */
+// Lê sem esperar tudo o que chegou na conexão; false quando o sketch a fechou
+bool receber(int conexao, std::string& recebido) {
+  char parte[4096];
+  ssize_t lidos;
+  while ((lidos = recv(conexao, parte, sizeof(parte), MSG_DONTWAIT)) > 0) recebido.append(parte, lidos);
+  return lidos != 0;
+}
+
+// Quantidade de números no array JSON "campo" do evento
+size_t elementosDoArray(const std::string& dados, const std::string& campo) {
+  size_t inicio = dados.find("\"" + campo + "\": [");
+  if (inicio == std::string::npos) return 0;
+  inicio = dados.find('[', inicio) + 1;
+  size_t fim = dados.find(']', inicio);
+  if (fim == inicio) return 0;
+  return std::count(dados.begin() + inicio, dados.begin() + fim, ',') + 1;
+}
+
+void testeStream() {
+  simulacao::serialSilenciosa = true;
+  setup();
+  while (millis() < 120000) loop();    // Primeira sincronização do NTP e algumas leituras
+  int conexoes[MAX_ASSINANTES];
+  for (int& conexao : conexoes) conexao = server.atender(simulacao::requisicao("/stream")).conexao;
+  VERIFICAR_IGUAL(server.atender(simulacao::requisicao("/stream")).codigo, 503);
+  int rapido = conexoes[0], lento = conexoes[1];
+  close(conexoes[2]);                  // Fechadas pelo navegador: liberadas no próximo pulso
+  close(conexoes[3]);
+  // Socket mínimo do assinante lento: o buffer do sketch para ele enche em poucos eventos
+  int minimo = 1;
+  setsockopt(lento, SOL_SOCKET, SO_RCVBUF, &minimo, sizeof(minimo));
+  setsockopt(assinantes[1].cliente.fd(), SOL_SOCKET, SO_SNDBUF, &minimo, sizeof(minimo));
+
+  uint32_t seqInicial = historico.total();
+  std::string recebidoRapido;
+  while (millis() < 1920000) {         // 30 minutos
+    loop();
+    receber(rapido, recebidoRapido);
+  }
+  VERIFICAR(assinantes[0].ativo);
+  VERIFICAR(!assinantes[1].ativo);     // Lento: desconectado ao encher o buffer
+  VERIFICAR(!assinantes[2].ativo && !assinantes[3].ativo);
+  std::string recebidoLento;
+  while (receber(lento, recebidoLento)) {}
+  close(lento);
+  VERIFICAR(recebidoLento.size() < recebidoRapido.size());
+  VERIFICAR(recebidoRapido.compare(0, recebidoLento.size(), recebidoLento) == 0); // Mesmos bytes até o corte
+
+  // Eventos: cabeçalho HTTP e "retry", depois "amostra" com as leituras desde o anterior, em ordem
+  size_t posicao = recebidoRapido.find("\r\n\r\nretry: 3000\n\n");
+  VERIFICAR(posicao != std::string::npos);
+  posicao += strlen("\r\n\r\nretry: 3000\n\n");
+  uint32_t seqAnterior = seqInicial;
+  int eventos = 0, pulsos = 0;
+  while (posicao < recebidoRapido.size()) {
+    size_t fim = recebidoRapido.find("\n\n", posicao);
+    VERIFICAR(fim != std::string::npos);
+    if (fim == std::string::npos) break;
+    std::string evento = recebidoRapido.substr(posicao, fim - posicao);
+    posicao = fim + 2;
+    if (evento == ": pulso") {
+      pulsos++;
+      continue;
+    }
+    const std::string prefixo = "event: amostra\ndata: {";
+    VERIFICAR(evento.compare(0, prefixo.size(), prefixo) == 0 && evento.back() == '}');
+    VERIFICAR(evento.find('\n', prefixo.size()) == std::string::npos); // "data" em uma única linha
+    uint32_t seq = strtoul(evento.c_str() + evento.find("\"seq\": ") + 7, NULL, 10);
+    VERIFICAR_IGUAL(elementosDoArray(evento, "temperaturas"), (size_t)(seq - seqAnterior));
+    VERIFICAR_IGUAL(elementosDoArray(evento, "umidades"), (size_t)(seq - seqAnterior));
+    seqAnterior = seq;
+    eventos++;
+  }
+  VERIFICAR_IGUAL(seqAnterior, historico.total()); // Nenhuma leitura ficou sem evento
+  VERIFICAR(eventos >= 170);                       // Uma leitura a cada 10 s
+  VERIFICAR(pulsos >= 100);                        // A cada 15 s
+
+  // Pior caso (valores extremos e todas as séries cheias): o evento sai inteiro
+  for (int i = 0; i < maxHoras * 6 + maxLeituras; i++) {
+    registrarAmostra(amostra(historico.back().epoch + 10, -4000, 10000), false);
+  }
+  seqPublicada = 0;
+  seqHorasPublicada = 0;
+  size_t antes = recebidoRapido.size();
+  publicarAmostras();
+  receber(rapido, recebidoRapido);
+  std::string ultimo = recebidoRapido.substr(antes);
+  VERIFICAR(ultimo.size() > TAMANHO_EVENTO / 2 && ultimo.size() <= TAMANHO_EVENTO);
+  VERIFICAR(ultimo.compare(ultimo.size() - 3, 3, "}\n\n") == 0);
+  VERIFICAR_IGUAL(elementosDoArray(ultimo, "temperaturas"), (size_t)maxLeituras);
+  VERIFICAR_IGUAL(elementosDoArray(ultimo, "mediasTempHoras"), (size_t)maxHoras);
+  close(rapido);
+}
+
+/*
+ * /metrics: baldes cumulativos em ordem crescente de "le", +Inf igual a _count, _sum em segundos
+ * e os contadores do sketch
+ */
+// Valor da linha "nome" (com rótulos, se houver) no metricas do Prometheus; -1 se ausente
+double valorMetrica(const std::string& metricas, const std::string& nome) {
+  size_t posicao = metricas.find("\n" + nome + " ");
+  if (posicao == std::string::npos) return -1;
+  return strtod(metricas.c_str() + posicao + nome.size() + 2, NULL);
+}
+
+void testeMetricas() {
+  simulacao::serialSilenciosa = true;
+  setup();
+  while (millis() < 600000) loop();
+
+  // Durações conhecidas em um histograma que o teste não exercita (sem alertas no período)
+  latenciaTelegram = Histograma("telegram");
+  for (uint32_t microssegundos : {10u, 16u, 17u, 100u, 524288u, 1000000u}) latenciaTelegram.registrar(microssegundos);
+
+  const WebServer::Resposta& resposta = server.atender(simulacao::requisicao("/metrics"));
+  VERIFICAR_IGUAL(resposta.codigo, 200);
+  const std::string& metricas = resposta.corpo;
+  const std::string telegram = "monitor_latencia_segundos_bucket{operacao=\"telegram\",le=";
+  VERIFICAR_IGUAL(valorMetrica(metricas, telegram + "\"0.000016\"}"), 2.0);
+  VERIFICAR_IGUAL(valorMetrica(metricas, telegram + "\"0.000032\"}"), 3.0);
+  VERIFICAR_IGUAL(valorMetrica(metricas, telegram + "\"0.000064\"}"), 3.0);
+  VERIFICAR_IGUAL(valorMetrica(metricas, telegram + "\"0.000128\"}"), 4.0);
+  VERIFICAR_IGUAL(valorMetrica(metricas, telegram + "\"0.262144\"}"), 4.0);
+  VERIFICAR_IGUAL(valorMetrica(metricas, telegram + "\"0.524288\"}"), 5.0);
+  VERIFICAR_IGUAL(valorMetrica(metricas, telegram + "\"+Inf\"}"), 6.0);
+  VERIFICAR_IGUAL(valorMetrica(metricas, "monitor_latencia_segundos_count{operacao=\"telegram\"}"), 6.0);
+  VERIFICAR(fabs(valorMetrica(metricas, "monitor_latencia_segundos_sum{operacao=\"telegram\"}") - 1.524431) < 1e-9);
+
+  // Todas as operações: "le" crescente, contagens que nunca diminuem e +Inf igual a _count
+  for (const Histograma* histograma : histogramas) {
+    std::string prefixo = std::string("monitor_latencia_segundos_bucket{operacao=\"") + histograma->nome + "\",le=\"";
+    double leAnterior = 0, anterior = 0;
+    int baldes = 0;
+    for (size_t posicao = metricas.find(prefixo); posicao != std::string::npos; posicao = metricas.find(prefixo, posicao + 1)) {
+      const char* le = metricas.c_str() + posicao + prefixo.size();
+      double limite = strncmp(le, "+Inf", 4) == 0 ? INFINITY : strtod(le, NULL);
+      double contagem = strtod(strchr(le, ' ') + 1, NULL);
+      VERIFICAR(limite > leAnterior);
+      VERIFICAR(contagem >= anterior);
+      leAnterior = limite;
+      anterior = contagem;
+      baldes++;
+    }
+    VERIFICAR_IGUAL(baldes, BALDES_LATENCIA + 1);
+    VERIFICAR(std::isinf(leAnterior));
+    std::string rotulo = std::string("{operacao=\"") + histograma->nome + "\"}";
+    VERIFICAR_IGUAL(anterior, valorMetrica(metricas, "monitor_latencia_segundos_count" + rotulo));
+    VERIFICAR_IGUAL(anterior, (double)histograma->contagem);
+    VERIFICAR(valorMetrica(metricas, "monitor_latencia_segundos_sum" + rotulo) >= 0);
+  }
+  VERIFICAR(valorMetrica(metricas, "monitor_latencia_segundos_count{operacao=\"loop\"}") > 1000);
+  VERIFICAR(valorMetrica(metricas, "monitor_latencia_segundos_count{operacao=\"sensor\"}") >= 59);
+
+  // Contadores e medidores
+  VERIFICAR_IGUAL(valorMetrica(metricas, "monitor_leituras_total{canal=\"principal\"}"), (double)canais[CANAL_PRINCIPAL].historico.total());
+  VERIFICAR_IGUAL(valorMetrica(metricas, "monitor_historico_leituras"), (double)historico.size());
+  VERIFICAR_IGUAL(valorMetrica(metricas, "monitor_ativo_segundos"), 600.0);
+  VERIFICAR(metricas.find("# TYPE monitor_latencia_segundos histogram\n") != std::string::npos);
+  VERIFICAR(!metricas.empty() && metricas.back() == '\n');
+}
+
+/*
+ * Canais: a tarefa de sensores lê os três canais em ordem, defasados de intervaloLeitura /
+ * NUM_CANAIS dentro de cada rodada, e cada canal a cada intervaloLeitura exato; /canais mostra
+ * cada um com seu histórico
+ */
+struct LeituraSensor {
+  uint8_t pino;
+  unsigned long ms;
+};
+std::vector<LeituraSensor> leiturasSensores;
+
+bool registrarLeituraSensor(uint8_t pino, double segundos, float& temperatura, float& umidade) {
+  leiturasSensores.push_back({pino, millis()});
+  return simulacao::leituraSintetica(pino, segundos, temperatura, umidade);
+}
+
+void testeCanais() {
+  VERIFICAR_IGUAL(NUM_CANAIS, 3);
+  simulacao::serialSilenciosa = true;
+  simulacao::fonteLeituras = registrarLeituraSensor;
+  setup();
+  while (millis() < 608000) loop();    // Termina depois do último canal da rodada de 600 s
+
+  const uint8_t pinos[] = {DHTPIN, 16, 17};
+  VERIFICAR(leiturasSensores.size() >= 3 * 59);
+  for (size_t i = 0; i < leiturasSensores.size(); i++) {
+    VERIFICAR_IGUAL(leiturasSensores[i].pino, pinos[i % NUM_CANAIS]);
+    unsigned long rodada = leiturasSensores[i - i % NUM_CANAIS].ms;
+    VERIFICAR_IGUAL(leiturasSensores[i].ms - rodada, (i % NUM_CANAIS) * intervaloLeitura / NUM_CANAIS);
+    if (i >= (size_t)NUM_CANAIS) VERIFICAR_IGUAL(leiturasSensores[i].ms - leiturasSensores[i - NUM_CANAIS].ms, intervaloLeitura);
+  }
+  VERIFICAR_IGUAL(leiturasDescartadas, 0u);
+
+  // /canais: cada canal com suas leituras e a última no seu próprio instante
+  const WebServer::Resposta& todos = server.atender(simulacao::requisicao("/canais"));
+  VERIFICAR_IGUAL(todos.codigo, 200);
+  for (const char* nome : {"\"principal\"", "\"rack2\"", "\"rack3\""}) VERIFICAR(todos.corpo.find(nome) != std::string::npos);
+  for (int i = 0; i < NUM_CANAIS; i++) VERIFICAR_IGUAL(canais[i].historico.total(), canais[0].historico.total());
+  VERIFICAR_IGUAL(canais[1].historico.back().epoch - canais[0].historico.back().epoch, 3u);
+  VERIFICAR_IGUAL(canais[2].historico.back().epoch - canais[0].historico.back().epoch, 6u);
+  const WebServer::Resposta& um = server.atender(simulacao::requisicao("/canais?canal=2"));
+  VERIFICAR_IGUAL(um.codigo, 200);
+  VERIFICAR(um.corpo.find("\"nome\": \"rack3\"") != std::string::npos);
+  VERIFICAR(um.corpo.find("\"temperaturas\": [") != std::string::npos);
+  VERIFICAR_IGUAL(server.atender(simulacao::requisicao("/canais?canal=3")).codigo, 404);
+}
+
+/*
+ * Agenda: loop ocioso acorda ~100 vezes por segundo, prazos perdidos aparecem em /agenda e a tabela
+ * de temporizadores recusa registros além de MAX_TEMPORIZADORES
+ */
+int chamadasLento = 0;
+void temporizadorLento() {
+  if (chamadasLento++ == 0) delay(2500); // Primeira execução estoura dois prazos de 1 s
+}
+
+void testeAgenda() {
+  simulacao::serialSilenciosa = true;
+  setup();
+  while (millis() < 70000) loop();
+  VERIFICAR(!sonoLeveAtivo);              // Simulação sem CONFIG_PM_ENABLE nem tickless idle
+  VERIFICAR(!frequenciaDinamicaAtiva);
+  unsigned long despertaresAntes = despertares;
+  unsigned long inicio = millis();
+  while (millis() < inicio + 60000) loop();
+  unsigned long porSegundo = (despertares - despertaresAntes) / 60;
+  printf("despertares por segundo: %lu\n", porSegundo);
+  VERIFICAR(porSegundo >= 90 && porSegundo <= 1000 / intervaloRede);
+
+  VERIFICAR_IGUAL(numTemporizadores, MAX_TEMPORIZADORES - 1);
+  Temporizador* lento = agendar("lento", 1000, temporizadorLento);
+  VERIFICAR(lento != NULL);
+  VERIFICAR(agendar("excedente", 1000, temporizadorLento) == NULL);
+  VERIFICAR_IGUAL(numTemporizadores, MAX_TEMPORIZADORES);
+  inicio = millis();
+  while (millis() < inicio + 5000) loop();
+  VERIFICAR_IGUAL(lento->perdidos, 1u);   // Disparo em 1 s atrasou até 3,5 s: o prazo de 2 s foi pulado
+  VERIFICAR(lento->atrasoMaximo >= 1500);
+
+  const WebServer::Resposta& agenda = server.atender(simulacao::requisicao("/agenda"));
+  VERIFICAR_IGUAL(agenda.codigo, 200);
+  for (const char* campo : {"\"despertares\": ", "\"sonoLeve\": false", "\"frequenciaDinamica\": false",
+                            "\"nome\": \"amostragem\"", "\"nome\": \"lento\"", "\"perdidos\": 1 }"})
+    VERIFICAR(agenda.corpo.find(campo) != std::string::npos);
+  VERIFICAR(agenda.corpo.find("excedente") == std::string::npos);
+}
+
+/*
+ * Alertas: o envio ao Telegram não bloqueia o loop, agrupa rajadas e repete com espera crescente
+ */
+void testeAlertas() {
+  simulacao::serialSilenciosa = true;
+  simulacao::latenciaTelegramMs = 5000;
+  simulacao::fonteLeituras = [](uint8_t, double, float& temperatura, float& umidade) {
+    temperatura = 20;                    // Abaixo de todas as regras padrão
+    umidade = 50;
+    return true;
+  };
+  setup();
+  Amostra leitura = amostra(epochAtual(), 3000, 5000);
+  for (int i = 0; i < 5; i++) enfileirarAlerta(regras[0], leitura, 3000, false);
+  unsigned long despertaresAntes = despertares;
+  unsigned long fim = millis() + 4000;
+  while (millis() < fim) loop();        // O envio leva 5 s, mas o loop continua atendendo
+  VERIFICAR(despertares - despertaresAntes > 300);
+  VERIFICAR(simulacao::mensagensTelegram.empty());
+  simulacao::avancar(2000);
+  VERIFICAR_IGUAL(simulacao::mensagensTelegram.size(), 1u);
+  VERIFICAR_IGUAL(std::count(simulacao::mensagensTelegram[0].begin(), simulacao::mensagensTelegram[0].end(), '\n'), 4);
+  VERIFICAR(simulacao::mensagensTelegram[0].find("Temperatura alta [principal] 30.00°C") != std::string::npos);
+  VERIFICAR_IGUAL(alertasEnviados, 1ul);
+
+  // Falha: TENTATIVAS_ALERTA tentativas com esperas de 2, 4 e 8 s
+  simulacao::telegramFalhando = true;
+  enfileirarAlerta(regras[0], leitura, 3000, false);
+  simulacao::avancar(4 * 5000 + 2000 + 4000 + 8000 - 100);
+  VERIFICAR_IGUAL(alertasFalhos, 0ul);
+  simulacao::avancar(200);
+  VERIFICAR_IGUAL(alertasFalhos, 1ul);
+  VERIFICAR_IGUAL(simulacao::mensagensTelegram.size(), 1u);
+
+  // Fila cheia: o loop descarta sem esperar
+  simulacao::telegramFalhando = false;
+  for (int i = 0; i < TAMANHO_FILA_ALERTAS + 3; i++) enfileirarAlerta(regras[0], leitura, 3000, false);
+  VERIFICAR_IGUAL(alertasDescartados, 3ul);
+  simulacao::avancar(10000);
+  VERIFICAR_IGUAL(simulacao::mensagensTelegram.size(), 2u);
+  VERIFICAR_IGUAL(std::count(simulacao::mensagensTelegram[1].begin(), simulacao::mensagensTelegram[1].end(), '\n'),
+                  TAMANHO_FILA_ALERTAS - 1);
+}
+
+/*
+ * Relógio virtual: delay() e as esperas das tarefas avançam o tempo direto até o próximo prazo
+ */
+int voltasTarefa = 0;
+QueueHandle_t filaTeste;
+int recebido = 0;
+
+void testeRelogio() {
+  VERIFICAR_IGUAL(millis(), 0ul);
+  delay(1500);
+  VERIFICAR_IGUAL(millis(), 1500ul);
+
+  // Tarefa periódica: acorda a cada 100 ms enquanto o loop principal espera
+  xTaskCreatePinnedToCore([](void*) {
+    for (;;) {
+      vTaskDelay(pdMS_TO_TICKS(100));
+      voltasTarefa++;
+    }
+  }, "teste", 4096, NULL, 1, NULL, 0);
+  simulacao::avancar(1000);
+  VERIFICAR_IGUAL(voltasTarefa, 10);
+  VERIFICAR_IGUAL(millis(), 2500ul);
+
+  // Fila: a tarefa que espera sem prazo acorda com o envio, sem o tempo avançar
+  filaTeste = xQueueCreate(4, sizeof(int));
+  xTaskCreatePinnedToCore([](void*) {
+    int valor;
+    for (;;) {
+      xQueueReceive(filaTeste, &valor, portMAX_DELAY);
+      recebido += valor;
+    }
+  }, "fila", 4096, NULL, 1, NULL, 0);
+  int valor = 7;
+  xQueueSend(filaTeste, &valor, 0);
+  xQueueSend(filaTeste, &valor, 0);
+  simulacao::avancar(0);
+  VERIFICAR_IGUAL(recebido, 14);
+  VERIFICAR_IGUAL(millis(), 2500ul);
+
+  // O loop principal esperando uma fila acorda quando um item chega, ou no prazo
+  int lido;
+  VERIFICAR_IGUAL(xQueueReceive(xQueueCreate(1, sizeof(int)), &lido, 250), pdFALSE);
+  VERIFICAR_IGUAL(millis(), 2750ul);
+}
+
+/*
+ * Traço gravado: as leituras do sketch seguem o arquivo, no tempo virtual
+ */
+void testeTraco() {
+  char caminho[] = "/tmp/monitoramento-traco-XXXXXX";
+  int descritor = mkstemp(caminho);
+  FILE* arquivo = fdopen(descritor, "w");
+  fprintf(arquivo, "segundos,temperatura,umidade\n");
+  for (int segundos = 0; segundos < 3600; segundos += 10) {
+    if (segundos == 1800) fprintf(arquivo, "%d,nan,nan\n", segundos); // Leitura inválida do sensor
+    else fprintf(arquivo, "%d,%.1f,%.1f\n", segundos, 20 + segundos / 100.0, 50.0);
+  }
+  fclose(arquivo);
+  VERIFICAR(simulacao::carregarTraco(caminho));
+  unlink(caminho);
+
+  simulacao::serialSilenciosa = true;
+  setup();
+  while (millis() < 3000000) loop();   // Menos que o traço: sem repetir o início
+  VERIFICAR(historico.size() >= 290);
+  VERIFICAR_IGUAL(canais[CANAL_PRINCIPAL].falhas, 1u);
+  // Cada leitura tem o valor do traço no seu instante: +0,1 °C a cada 10 s (0,2 na leitura inválida)
+  std::map<int32_t, int> passos;
+  int32_t anterior = INT32_MIN;
+  for (const Amostra& leitura : historico) { // A série decodifica cada leitura em um temporário
+    if (anterior != INT32_MIN) passos[leitura.temperatura - anterior]++;
+    anterior = leitura.temperatura;
+  }
+  VERIFICAR_IGUAL(passos.size(), 2u);
+  VERIFICAR_IGUAL(passos[20], 1);
+  VERIFICAR_IGUAL(passos[10], (int)historico.size() - 2);
+  VERIFICAR_IGUAL(historico.back().umidade, 5000);
+}
+
+/*
+ * Relógio sem NTP no início: as leituras anteriores à primeira resposta são descartadas e as
+ * gravadas depois têm instantes reais, em ordem
+ */
+void testeNtp() {
+  simulacao::serialSilenciosa = true;
+  simulacao::epochInicial = EPOCH;
+  simulacao::ntpDisponivelAposMs = 150000;
+  setup();
+  VERIFICAR(!relogioSincronizado);
+  while (millis() < 600000) loop();
+  VERIFICAR(relogioSincronizado);
+  VERIFICAR(leiturasSemRelogio >= 15);    // Leitura a cada 10 s até a sincronização de 180 s
+  VERIFICAR(historico.size() > 0);
+  const uint32_t local = EPOCH - 10800;   // Fuso UTC-3
+  uint32_t anterior = 0;
+  for (const Amostra& leitura : historico) {
+    VERIFICAR(leitura.epoch >= local + 150 && leitura.epoch <= local + 600);
+    VERIFICAR(leitura.epoch >= anterior);
+    anterior = leitura.epoch;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::map<std::string, void (*)()> testes = {
+      {"relogio", testeRelogio}, {"traco", testeTraco}, {"json", testeJson}, {"ringbuffer", testeRingBuffer},
+      {"serie", testeSerie}, {"agregacao", testeAgregacao}, {"regras", testeRegras}, {"nomes", testeNomes},
+      {"dados", testeDados}, {"flash", testeFlash}, {"reinicio", testeReinicio}, {"exportacao", testeExportacao},
+      {"stream", testeStream}, {"metricas", testeMetricas}, {"canais", testeCanais}, {"agenda", testeAgenda},
+      {"alertas", testeAlertas}, {"ntp", testeNtp},
+  };
+  auto teste = argc == 2 ? testes.find(argv[1]) : testes.end();
+  if (teste == testes.end()) {
+    fprintf(stderr, "Uso: testes <nome>; nomes:");
+    for (const auto& par : testes) fprintf(stderr, " %s", par.first.c_str());
+    fprintf(stderr, "\n");
+    return 2;
+  }
+  teste->second();
+  printf("%s: %s\n", teste->first.c_str(), falhas ? "FALHOU" : "ok");
+  simulacao::encerrar(falhas ? 1 : 0);
+}